@@ -45,6 +45,7 @@ const     UINT_PTR        IDT_REFRESH_UPDATER   =             1342;
 const     UINT_PTR        IDT_REFRESH_NOTIFY    =             1343;
 const     UINT_PTR        IDT_REFRESH_DIR_ROOT  =             1344; // Used by the directory watch for the root folder
 const     UINT_PTR       cIDT_TIMER_EFFICIENCY  =             1345; // Engages Efficiency Mode (Win11) and compacts the working set
+const     UINT_PTR        IDT_REFRESH_APPINFO   =             1346; // Used by the directory watch for Steam's appinfo.vdf
 //const   UINT_PTR        IDT_REFRESH_STEAM_LIB =        1983-1999; // Used by the directory watch for Steam libraries
 
 // Desktop notification types
@@ -69,6 +70,7 @@ constexpr UINT           WM_SKIF_UPDATER        = WM_USER + 0x2051; // Updater w
 constexpr UINT           WM_SKIF_ICON           = WM_USER + 0x2052; // Patreon/Cover/Icon textures workers completed...
 constexpr UINT           WM_SKIF_REFRESHCOVER   = WM_USER + 0x2053; // Refresh Cover -- Update Cover worker completed
 constexpr UINT           WM_SKIF_REFRESHFOCUS   = WM_USER + 0x2054; // Trigger a new focus check from the main thread (used by child threads, e.g. gamepad input thread)
+constexpr UINT           WM_SKIF_APPINFO        = WM_USER + 0x2055; // AppInfo workers completed a batch of Steam apps
 
 // Callbacks / Event Signals
 constexpr UINT           WM_SKIF_POWERMODE      = WM_USER + 0x2101; // Used to signal that a new effective power mode has been applied
@@ -41,6 +41,9 @@
 #include <utility/vfs.h>
 
 #include <vector>
+#include <memory>
+
+struct SK_Steam_KeyValueTree; // steam_library.h
 
 //
 // TODO: Get this specialization stuff the hell out of here...
@@ -86,6 +89,19 @@ private:
 struct app_record_s {
   app_record_s (uint32_t id_) : id (id_) { };
 
+  app_record_s            (app_record_s&&)      = default;
+  app_record_s& operator= (app_record_s&&)      = default;
+
+  // Records are large and are moved between the library worker and the UI,
+  //   so copying one has to be asked for explicitly through clone ( )
+  app_record_s clone (void) const;
+
+private:
+  app_record_s            (const app_record_s&) = default;
+  app_record_s& operator= (const app_record_s&) = default;
+
+public:
+
   struct client_state_s {
     bool refresh    (app_record_s *pApp);
 
@@ -441,6 +457,8 @@ struct app_record_s {
 
     std::string  manifest_data    =  "";
     std::wstring manifest_path    = L"";
+    std::shared_ptr <SK_Steam_KeyValueTree>
+                 manifest_kv;                 // manifest_data parsed once, shared by copies of the record
     std::string  branch           = "public"; // Holds the current "beta" branch set in the Steam client (default: public)
   } steam;
 
@@ -1,7 +1,10 @@
 #ifndef STEAM_APPS_IGNORABLE_H
 #define STEAM_APPS_IGNORABLE_H
 
-static constexpr unsigned int steam_apps_ignorable[] = {
+#include <array>
+#include <cstdint>
+
+inline constexpr unsigned int steam_apps_ignorable[] = {
   496450,
   1787090,
   1802970,
@@ -52544,4 +52547,46 @@ static constexpr unsigned int steam_apps_ignorable[] = {
   26110
 };
 
+// The list above is kept as-is for maintenance; lookups go through a bitmap over
+//   the appid range instead, which is built from it at compile time (~250 KB).
+//     Building it exceeds MSVC's default constexpr step limit, see /constexpr:steps in SKIF.vcxproj.
+namespace steam_apps_ignorable_impl
+{
+  constexpr unsigned int
+  max_appid (void)
+  {
+    unsigned int max = 0;
+
+    for (auto appid : steam_apps_ignorable)
+      if (appid > max)
+        max = appid;
+
+    return max;
+  }
+
+  using bitmap_t =
+    std::array <uint64_t, max_appid ( ) / 64 + 1>;
+
+  constexpr bitmap_t
+  build_bitmap (void)
+  {
+    bitmap_t bits = { };
+
+    for (auto appid : steam_apps_ignorable)
+      bits [appid / 64] |= 1ULL << (appid % 64);
+
+    return bits;
+  }
+
+  inline constexpr bitmap_t bitmap = build_bitmap ( );
+}
+
+// Returns true if the Steam app is a DLC, tool, soundtrack, etc. that should not be listed
+constexpr bool
+SKIF_Steam_isIgnorableApp (unsigned int appid)
+{
+  return appid / 64 < steam_apps_ignorable_impl::bitmap.size ( ) &&
+        (steam_apps_ignorable_impl::bitmap [appid / 64] >> (appid % 64)) & 1ULL;
+}
+
 #endif
@@ -0,0 +1,144 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <initializer_list>
+
+// Streaming tokenizer for text KeyValues (.acf / .vdf), nothing is kept besides
+//   the current key and value. Handles quoted and unquoted tokens, escape
+//     sequences, // comments and [$...] conditionals. A } lacking a matching {
+//       is dropped and sections still open at the end of the input are implied.
+class SK_Steam_KeyValueReader
+{
+public:
+  enum class Event {
+    End,
+    KeyValue,     // key () and value () are set
+    SectionBegin, // key () is the name of the section
+    SectionEnd
+  };
+
+  explicit
+  SK_Steam_KeyValueReader (std::string_view input) : _input (input) { }
+
+  Event              next  (void);
+
+  // Valid until the next call to next ( )
+  const std::string& key   (void) const { return _key;   }
+  const std::string& value (void) const { return _value; }
+
+  // Number of sections currently open
+  size_t             depth (void) const { return _depth; }
+
+private:
+  enum class _Token { End, String, Open, Close };
+
+  _Token           _next  (void);
+
+  std::string_view _input;
+  size_t           _pos   = 0;
+  size_t           _depth = 0;
+  std::string      _token;
+  std::string      _key;
+  std::string      _value;
+};
+
+// Path queries answered in one streaming pass, e.g. "libraryfolders/*/path".
+//   Components are matched case-insensitively and '*' matches any one key.
+class SK_Steam_KeyValueQuery
+{
+public:
+  struct match_s {
+    size_t                    pattern;  // Index of the pattern that matched
+    std::vector <std::string> captures; // Keys matched by each '*', outermost first
+    std::string               value;
+  };
+
+  explicit
+  SK_Steam_KeyValueQuery (std::initializer_list <std::string_view> patterns);
+
+  // Matches are returned in file order
+  std::vector <match_s> run (std::string_view input) const;
+
+private:
+  std::vector <std::vector <std::string>> _patterns;
+};
+
+// Text KeyValues parsed in a single pass (through SK_Steam_KeyValueReader) into a
+//   flat node array. Children are looked up case-insensitively through a hash table
+//     keyed by (parent, case-folded key), built along with the tree as it is shared
+//       between threads and never modified afterwards.
+struct SK_Steam_KeyValueTree
+{
+  static constexpr uint32_t npos = UINT32_MAX;
+
+  struct node_s {
+    std::string key;
+    std::string value;             // Empty for sections
+    uint32_t    parent   = npos;
+    uint32_t    first    = npos;   // First child, in file order
+    uint32_t    next     = npos;   // Next sibling, in file order
+    uint32_t    count    = 0;      // Number of children
+    uint32_t    hash     = 0;      // Case-folded hash of key
+    bool        section  = false;
+  };
+
+  std::vector <node_s>   nodes;    // nodes [0] is the unnamed root
+  std::vector <uint32_t> index;    // Open-addressed (linear probing) table of every node but the root
+
+  SK_Steam_KeyValueTree (void) = default;
+  explicit
+  SK_Steam_KeyValueTree (std::string_view input) { parse (input); }
+
+  void               parse    (std::string_view input);
+
+  // Returns npos if not found; duplicate keys resolve to the first one in the file
+  uint32_t           find     (uint32_t section, std::string_view key)              const;
+  uint32_t           find     (uint32_t section, uint64_t         numeric_key)      const; // e.g. an appid, without a temporary string
+  uint32_t           find     (std::initializer_list <std::string_view> path)       const;
+
+  // Value of the key at the end of the path, or an empty string
+  const std::string& getValue (std::initializer_list <std::string_view> path)       const;
+
+  // Calls fn (const node_s&) for each direct child of the section, in file order
+  template <typename _Fn>
+  void               forEach  (uint32_t section, _Fn fn)                            const
+  {
+    if (section >= nodes.size ())
+      return;
+
+    for ( uint32_t child  = nodes [section].first ;
+                   child != npos ;
+                   child  = nodes [child].next )
+      fn (nodes [child]);
+  }
+};
+
+// Position of the first '"' or '\\' at or after pos, or the end of the input.
+//   The reader uses the vectorised one; the scalar one is its tail loop.
+size_t SK_Steam_KeyValues_FindQuote       (std::string_view input, size_t pos);
+size_t SK_Steam_KeyValues_FindQuoteScalar (std::string_view input, size_t pos);
@@ -0,0 +1,58 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The appmanifest files of a Steam library. Kept up to date from individual
+//   file change events, which makes it independent of where those come from
+//     (ReadDirectoryChangesW in SKIF); a full rescan is only needed on overflow.
+struct SK_Steam_ManifestSet
+{
+  struct change_s {
+    enum class Action {
+      Added,
+      Removed,
+      Overflow  // Events were lost, the set has to be rescanned
+    }            action;
+    std::wstring name;  // File name, relative to the steamapps folder
+  };
+
+  std::set <std::wstring> files;         // Lower-cased file names, relative to the steamapps folder
+  bool                    rescan = true; // Never scanned, or events were lost
+
+  // Replaces the set with a full listing of the steamapps folder, anything but appmanifest_*.acf is ignored
+  void scan  (const std::vector <std::wstring>& names);
+
+  // Returns true if any manifests were added or removed
+  bool apply (const std::vector <change_s>& changes);
+
+  static bool     isManifestName (std::wstring_view name);
+
+  // Returns the appid of an appmanifest_<appid>.acf name in any case, or 0 if it is not one
+  static uint32_t appidOf        (std::wstring_view name);
+};
@@ -25,6 +25,8 @@
 #include <Windows.h>
 #include <vector>
 #include <stack>
+#include <string_view>
+#include <initializer_list>
 
 #include <stores/Steam/app_record.h>
 #include "utility/sk_utility.h"
@@ -32,6 +34,8 @@
 //#include "steam/steam_api.h"
 #include <utility/vfs.h>
 #include <stores/Steam/vdf.h>
+#include <stores/Steam/keyvalues.h>
+#include <stores/Steam/manifest_set.h>
 
 
 extern
@@ -53,190 +57,6 @@ enum ConfigStore
 };
 
 
-// Barely functional Steam Key/Value Parser
-//   -> Does not handle unquoted kv pairs.
-//   -> Does also not handle a hanging { that lacks a closing } (worked around by counting the depth we end up on)
-class SK_Steam_KeyValues
-{
-public:
-  static
-  std::vector <std::string>
-  getKeys ( const std::string               &input,
-            const std::deque  <std::string> &sections,
-                  std::vector <std::string> *values = nullptr )
-  {
-    std::vector <std::string> ret;
-
-    if (sections.empty () || input.empty ())
-      return ret;
-
-    // TODO: Fix proper solution to the below
-    // This is a halfassed way of ensuring there's a matching set of { and }
-    // ---
-    int depth = 0;
-
-    for (auto c : input)
-    {
-      if (c == '{')
-        depth++;
-      if (c == '}' && depth > 0)
-        depth--;
-    }
-
-    if (depth != 0)
-      return ret;
-    // ---
-
-    struct {
-      std::deque <std::string> path;
-
-      struct {
-        std::string actual;
-        std::string test;
-      } heap;
-
-      void heapify (std::deque <std::string> const *sections = nullptr)
-      {
-        int i = 0;
-
-        auto& in  = (sections == nullptr) ? path        : *sections;
-        auto& out = (sections == nullptr) ? heap.actual : heap.test;
-
-        out = "";
-
-        for ( auto& str : in )
-        {
-          if (i++ > 0)
-            out += "\x01";
-
-          out += str;
-        }
-      }
-    } search_tree;
-
-    search_tree.heapify (&sections);
-
-    std::string name   = "";
-    std::string value  = "";
-    int         quotes = 0;
-
-    const auto _clear = [&](void)
-    {
-      name.clear  ();
-      value.clear ();
-      quotes = 0;
-    };
-
-    for (auto c : input)
-    {
-      if (c == '"')
-        ++quotes;
-
-      else if (c != '{')
-      {
-        if (quotes == 1)
-        {
-          name += c;
-        }
-
-        if (quotes == 3)
-        {
-          value += c;
-        }
-      }
-
-      if (quotes == 4)
-      {
-        if (! _stricmp ( search_tree.heap.test.c_str   (),
-                         search_tree.heap.actual.c_str () ) )
-        {
-          ret.emplace_back (name);
-
-          if (values != nullptr)
-            values->emplace_back (value);
-        }
-
-        _clear ();
-      }
-
-      if (c == '{')
-      {
-        search_tree.path.push_back (name);
-        search_tree.heapify        (    );
-
-        _clear ();
-      }
-
-      else if (c == '}')
-      {
-        if (! search_tree.path.empty())
-          search_tree.path.pop_back ();
-        else
-          PLOG_ERROR << "Corrupt manifest detected!";
-
-        _clear ();
-      }
-
-      else { search_tree.heapify (); } // Needed to be able to handle key/value pairs placed after { } objects
-    }
-
-    return ret;
-  }
-
-  static
-  std::string
-  getValue ( const std::string              &input,
-             const std::deque <std::string> &sections,
-             const std::string              &key )
-  {
-    std::vector <std::string> values;
-    std::vector <std::string> keys (
-      SK_Steam_KeyValues::getKeys (input, sections, &values)
-    );
-
-    int idx = 0;
-
-    for ( auto& it : keys )
-    {
-      if (it._Equal (key))
-        return values [idx];
-
-      ++idx;
-    }
-
-    return "";
-  }
-
-  static
-  std::wstring
-  getValueAsUTF16 ( const std::string              &input,
-                    const std::deque <std::string> &sections,
-                    const std::string              &key )
-  {
-    std::vector <std::string> values;
-    std::vector <std::string> keys (
-      SK_Steam_KeyValues::getKeys (input, sections, &values)
-    );
-
-    int idx = 0;
-
-    for ( auto& it : keys )
-    {
-      if (it._Equal (key))
-      {
-        return
-          SK_UTF8ToWideChar (
-            values [idx]
-          );
-      }
-
-      ++idx;
-    }
-
-    return L"";
-  }
-};
-
 int                          SK_VFS_ScanTree (SK_VirtualFS::vfsNode* pVFSRoot,
                                                             wchar_t* wszDir,
                                                             wchar_t* wszPattern        = L"*",
@@ -246,6 +66,7 @@ int                          SK_VFS_ScanTree (SK_VirtualFS::vfsNode* pVFSRoot,
 );
 int                          SK_Steam_GetLibraries               (steam_library_t **ppLibraries);
 std::string                  SK_GetManifestContentsForAppID      (app_record_s *app);
+const SK_Steam_KeyValueTree* SK_GetManifestForAppID              (app_record_s *app);
 const wchar_t *              SK_GetSteamDir                      (void);
 const  char   *              SK_GetSteamDirUTF8                  (void);
 std::wstring                 SK_UseManifestToGetInstallDir       (app_record_s *app);
@@ -260,6 +81,7 @@ std::string                  SKIF_Steam_GetUserConfigStorePath   (SteamId3_t use
 void                         SKIF_Steam_PreloadUserConfig        (SteamId3_t userid, std::vector <std::pair < std::string, app_record_s > > *apps, std::set <std::string> *apptickets);
 bool                         SKIF_Steam_isSteamOverlayEnabled    (AppId_t appid, SteamId3_t userid);
 bool                         SKIF_Steam_areLibrariesSignaled     (void);
+bool                         SKIF_Steam_isAppInfoSignaled        (void);
 void                         SKIF_Steam_GetInstalledAppIDs       (std::vector <std::pair < std::string, app_record_s > > *apps);
 bool                         SKIF_Steam_HasActiveProcessChanged  (std::vector <std::pair < std::string, app_record_s > > *apps, std::set <std::string> *apptickets);
 SteamId3_t                   SKIF_Steam_GetCurrentUser           (void);
@@ -3,6 +3,9 @@
 #include <string>
 #include <cstdint>
 #include <vector>
+#include <memory>
+#include <span>
+#include <map>
 #include <wtypes.h>
 //#include <steam/isteamuser.h>
 #include "app_record.h"
@@ -16,12 +19,59 @@ typedef uint64 PublishedFileId_t;
 typedef uint64 ManifestId_t;
 typedef uint64 UGCHandle_t;
 
+// Raw values extracted from an app's appinfo.vdf KeyValues, before they are
+//   resolved against the local install (paths, account ids, custom launches)
+struct appinfo_data_s {
+  struct root_override_s {
+    std:: string root;
+    std:: string use_instead;
+    std::wstring add_path;
+  };
+
+  struct save_file_s {
+    std:: string           root;
+    std::wstring           path;
+    app_record_s::Platform platforms = app_record_s::Platform::Unknown;
+    bool                   has_root  = false;
+    bool                   has_path  = false;
+  };
+
+  bool                                           has_common    = false;
+  app_record_s::common_config_s                  common;
+  std::string                                    vac_module;
+  int                                            hide_cloud_ui = -1;
+  std::map    <int, app_record_s::launch_config_s> launch_configs; // Keyed by Steam's launch index
+  std::map    <std::string,
+                    app_record_s::branch_record_s> branches;
+  std::vector <root_override_s>                  root_overrides;
+  std::map    <int, save_file_s>                 save_files;
+};
+
 #pragma pack(push)
 #pragma pack(1)
 class skValveDataFile
 {
 public:
-  skValveDataFile (std::wstring source);
+  enum class LoadMode {
+    Buffered, // Reads the whole file into a heap allocated buffer
+    Mapped,   // Maps the file read-only and parses it in-place (no copy)
+    Windowed  // Slides a bounded view over the file, for files too large for the address space
+  };
+
+#ifdef _WIN64
+  static constexpr LoadMode DefaultMode = LoadMode::Mapped;
+#else
+  static constexpr LoadMode DefaultMode = LoadMode::Windowed;
+#endif
+
+  // Size of the view a LoadMode::Windowed reader slides over the file
+  static constexpr size_t   WindowSize  = 64ULL * 1024ULL * 1024ULL;
+
+  skValveDataFile (std::wstring source, LoadMode mode = DefaultMode);
+ ~skValveDataFile (void);
+
+  skValveDataFile            (const skValveDataFile&) = delete;
+  skValveDataFile& operator= (const skValveDataFile&) = delete;
 
   static constexpr
     uint32_t _LastSteamApp = 0;
@@ -61,27 +111,131 @@ public:
         SectionEnd   = 0x8
       };
 
-      using _kv_pair =
-        std::pair <const char*, std::pair <_TokenOp, void *>>;
+      // Classification of a section by its path, assigned while parsing
+      //   so that callers never have to build or compare dotted names
+      enum _PathId : uint8_t {
+        Ignored = 0,
+        AppInfo,                   // appinfo
+        Common,                    // appinfo.common (and anything below it)
+        CommonLibraryAssets,       // appinfo.common.library_assets_full
+        CommonLibraryCapsule,      // appinfo.common.library_assets_full.library_capsule
+        CommonLibraryCapsuleImage, // appinfo.common.library_assets_full.library_capsule.image
+        Extended,                  // appinfo.extended (and anything below it)
+        Config,                    // appinfo.config
+        ConfigLaunch,              // appinfo.config.launch
+        LaunchEntry,               // appinfo.config.launch.<n> (and anything below it)
+        UFS,                       // appinfo.ufs
+        RootOverrides,             // appinfo.ufs.rootoverrides
+        RootOverride,              // appinfo.ufs.rootoverrides.<n> (and anything below it)
+        SaveFiles,                 // appinfo.ufs.savefiles
+        SaveFile,                  // appinfo.ufs.savefiles.<n>
+        SaveFilePlatforms,         // appinfo.ufs.savefiles.<n>.platforms
+        Depots,                    // appinfo.depots
+        Branches,                  // appinfo.depots.branches
+        Branch                     // appinfo.depots.branches.<name>
+      };
+
+      // Section and key names SKIF looks at; everything else is Unknown.
+      //   Resolved once per string table entry (0x29+) or through a perfect
+      //     hash of the inline name (older files), so no string compares
+      //       are needed while walking the tape.
+      enum class _KeyId : uint8_t {
+        Unknown = 0,
+        // Sections
+        appinfo, common, extended, config, launch, ufs, depots, branches,
+        library_assets_full, library_capsule, image, rootoverrides, savefiles, platforms,
+        // Keys
+        osarch, type, icon, english, vacmodulefilename,
+        oslist, betakey, executable, arguments, description, workingdir, ownsdlc,
+        os, root, useinstead, addpath, path, hidecloudui,
+        buildid, pwdrequired, timeupdated,
+        _Count
+      };
+
+      static _KeyId lookupKey (const char* name);
 
-      struct section_data_s {
-        std::string            name;
-        section_desc_s         desc;
-        std::vector <_kv_pair> keys;
+      static constexpr uint32_t _NoParent = UINT32_MAX;
+
+      // Flat structure-of-arrays token tape, one row per token in file order.
+      //   The vectors are only ever cleared, so a section_s that is reused
+      //     across apps stops allocating once it has seen the largest one.
+      struct tape_s {
+        std::vector <uint8_t>      op;
+        std::vector <uint8_t>      path;   // _PathId of the section (or of the enclosing section for keys)
+        std::vector <_KeyId>       key;    // Interned name
+        std::vector <uint16_t>     depth;
+        std::vector <uint32_t>     parent; // Row of the enclosing SectionBegin
+        std::vector <uint32_t>     end;    // SectionBegin only: row of the matching SectionEnd
+        std::vector <const char*>  name;
+        std::vector <void*>        value;
+
+        std::vector <uint32_t>     open;   // Scratch stack of unclosed SectionBegin rows
+
+        size_t   size  (void) const { return op.size (); }
+        void     clear (void);
+        uint32_t push  (_TokenOp token, _PathId id, uint32_t parent_row, _KeyId key_id, const char* key, void* val);
+      } tape;
+
+      // A key/value row of the tape
+      struct key_s {
+        _KeyId      id;
+        const char* name;
+        _TokenOp    op;
+        void*       value;
       };
 
-      std::vector <
-        section_data_s
-      > finished_sections;
+      bool   exception     = false; // Set when malformed data was encountered
+      bool   selective     = true;  // Skip Ignored subtrees instead of adding them to the tape
+      size_t bytes_skipped = 0;     // Bytes of the last parse that were in skipped subtrees
+
+      void parse (section_desc_s& desc, const skValveDataFile& vdf);
 
-      void parse (section_desc_s& desc);
+      // Collects the keys directly inside the section at the given row, child sections are skipped
+      void keysOf (uint32_t row, std::vector <key_s>& keys) const;
+
+      // Row of the nearest ancestor (or self) that is a direct child of a section with the given path
+      uint32_t entryOf (uint32_t row, _PathId container) const;
     };
 
     void*      getRootSection (size_t* pSize = nullptr);
     appinfo_s* getNextApp     (void);
   };
 
-  appinfo_s* getAppInfo ( uint32_t     appid, std::vector <std::pair < std::string, app_record_s > > *apps );
+  struct app_index_s;
+
+  // appinfo.vdf is only held open while it is read from, so Steam remains free to
+  //   replace it in between. Every acquireFile ( ) that succeeded pins the file
+  //     (and sets base and root, unless LoadMode::Windowed) until the matching
+  //       releaseFile ( ). Fails once the file no longer is the one indexed.
+  bool               acquireFile (void);
+  void               releaseFile (void);
+
+  // Returns true if the record was populated using appinfo data
+  bool               getAppInfo (app_record_s* pAppRecord);
+  const app_index_s* findApp    (AppId_t       appid);
+
+  // Parses the given apps on a pool of worker threads; nothing is written to
+  //   the records until publishApps ( ) is called once the batch has finished.
+  bool       processApps  (std::span <app_record_s*> apps);
+  bool       isProcessing (void);
+
+  // Stops the workers of an unpublished batch and discards its results, for
+  //   when the records it was started on are about to be replaced
+  void       cancelProcessing (void);
+
+  // Must be called from the UI thread; swaps the results of a finished batch
+  //   into the matching records in one go. Returns true if anything changed.
+  bool       publishApps  (std::vector <std::pair < std::string, app_record_s > > *apps);
+
+  // Compares this file against a previously loaded copy and returns the apps
+  //   that were added or changed since (by change number and sha1). Cancels
+  //     any batch of the previous reader and adopts its extracted data cache.
+  std::vector <AppId_t>
+             supersede    (skValveDataFile& previous);
+
+  // Undoes what processing populated so the app gets processed again
+  static void
+             resetApp     (app_record_s* pAppRecord);
 
   struct header_s
   {
@@ -98,15 +252,73 @@ public:
     uint8_t   strings [1];
   };
 
-  header_s*  base  = nullptr;
-  appinfo_s* root  = nullptr;
+  // Built once when the file is loaded, sorted by appid
+  struct app_index_s {
+    AppId_t  appid;
+    uint32_t change_num;
+    uint32_t size;   // Size of the entry following the appid and size fields
+    uint64_t offset; // Offset of the appinfo_s header from the start of the file
+    uint64_t sha1;   // Leading bytes of sha1sum, used to tell changed apps apart
+  };
+
+  header_s*  base  = nullptr; // Only set while the whole file is in memory (not LoadMode::Windowed)
+  appinfo_s* root  = nullptr; // Only set while the whole file is in memory (not LoadMode::Windowed)
   str_tbl_s* table = nullptr;
 
+  std::vector <app_index_s> index;
+
 protected:
 private:
+  bool                 _loadMapped     (void);
+  bool                 _loadBuffered   (void);
+  bool                 _loadWindowed   (void);
+  bool                 _openFile       (void);
+  void                 _closeFile      (void);
+  void                 _indexFile      (void);
+  void                 _buildIndex     (void);
+  void                 _cancelBatch    (void);
+
+  bool                 _extractAppInfo (appinfo_s*    pIter,      appinfo_data_s& data);
+  void                 _applyAppInfo   (app_record_s* pAppRecord, const appinfo_data_s& data);
+
+  // Persistent cache of extracted data, keyed by appid + change number + sha1
+  void                 _cacheLoad      (void);
+  void                 _cacheSave      (void);
+  bool                 _cacheLookup    (appinfo_s* pIter,       appinfo_data_s& data);
+  void                 _cacheStore     (appinfo_s* pIter, const appinfo_data_s& data);
+
+  struct batch_s; // Defined in vdf_internal.h
+  std::unique_ptr <batch_s>
+                       _batch;
+
+  struct cache_s; // Defined in vdf_internal.h
+  std::unique_ptr <cache_s>
+                       _cache;
+
+  // Returns a pointer to the given range of the file, valid until it is released again
+  BYTE*                _acquireView    (uint64_t offset, size_t len);
+  void                 _releaseView    (BYTE*    pView);
+
+  struct file_s;   // Defined in vdf_internal.h, not used by LoadMode::Buffered
+  std::unique_ptr <file_s>
+                       _file;
+
+  struct window_s; // Defined in vdf_internal.h, only used by LoadMode::Windowed
+  std::unique_ptr <window_s>
+                       _window;
+
   std::wstring          path;
-  std::vector <BYTE>   _data;
+  LoadMode             _mode     = LoadMode::Buffered; // What the file ended up being loaded as
+  std::vector <BYTE>   _data;        // Only used by LoadMode::Buffered
+  HANDLE               _hFile    = INVALID_HANDLE_VALUE;
+  HANDLE               _hMapping = nullptr;
+  BYTE*                _mem      = nullptr; // Points to either _data or the mapped view (not LoadMode::Windowed)
+  uint64_t             _size     = 0;
+  uint64_t             _root_ofs = 0;       // Offset of the first app
+  std::vector <BYTE>   _strtbl;             // Copy of the string table (not LoadMode::Buffered)
   std::vector <char *>  strs; // Preparsed array of pointers
+  std::vector <appinfo_s::section_s::_KeyId>
+                        str_keys;   // Interned key of each string table entry
 };
 
 #pragma pack(pop)
\ No newline at end of file
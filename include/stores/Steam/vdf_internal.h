@@ -0,0 +1,79 @@
+//
+// Copyright 2020-2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+// Definitions of the state skValveDataFile only forward declares, shared by
+//   vdf.cpp (processing and caching) and vdf_reader.cpp (loading and parsing)
+
+#include <stores/Steam/vdf.h>
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+// State of an in-flight processApps ( ) batch
+struct skValveDataFile::batch_s {
+  skValveDataFile*             reader    = nullptr;
+  std::vector <app_record_s>   results;           // Private clones the workers write into
+  std::vector <HANDLE>         workers;
+  std::atomic <size_t>         next      = 0;
+  std::atomic <size_t>         active    = 0;
+  std::atomic <bool>           cancelled = false;
+  DWORD                        started   = 0;
+};
+
+// Extracted data of every app processed so far, persisted by _cacheSave ( )
+struct skValveDataFile::cache_s {
+  struct entry_s {
+    uint32_t       change_num    = 0;
+    uint8_t        sha1sum [20]  = { };
+    appinfo_data_s data;
+  };
+
+  std::mutex                             mutex;
+  std::unordered_map <AppId_t, entry_s>  entries;
+  std::wstring                           path;
+  bool                                   dirty = false;
+};
+
+// LoadMode::Mapped and LoadMode::Windowed; the file is opened by the first
+//   acquireFile ( ) and closed again by the last releaseFile ( )
+struct skValveDataFile::file_s {
+  std::mutex                         mutex;
+  size_t                             users      = 0;
+  FILETIME                           last_write = { }; // Of the file that was indexed
+  bool                               stale      = false;
+};
+
+// LoadMode::Windowed; one view that slides forward through the file, plus
+//   temporary views for ranges requested while the window is still in use
+struct skValveDataFile::window_s {
+  std::mutex                         mutex;
+  BYTE*                              view        = nullptr;
+  uint64_t                           begin       = 0;
+  size_t                             size        = 0;
+  size_t                             leases      = 0;
+  DWORD                              granularity = 64 * 1024;
+  std::vector <std::pair <BYTE*, BYTE*>>
+                                     temp_views; // Returned pointer, base of the view
+};
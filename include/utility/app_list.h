@@ -0,0 +1,137 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <stores/Steam/app_record.h>
+
+// Favorites are all grouped as such, and uncategorized games fall back to Games
+std::string SKIF_AppList_GetEffectiveCategory (const app_record_s* app);
+
+// Incremented by every sort and reposition of a list, lets views of the list tell that it was reordered
+uint32_t    SKIF_AppList_GetSortGeneration    (void);
+void        SKIF_AppList_BumpSortGeneration   (void);
+
+// Orders apps the way the library lists them: pinned state, then category for unpinned entries
+//   (uncategorized last), then the custom sort, and finally the name. sort is the library sort
+//     setting (SKIF_RegistrySettings::iLibrarySort): 0 = none, 1 = used count, 2 = last used.
+bool        SKIF_AppList_SortsBefore          (const app_record_s& a, const app_record_s& b, int sort);
+
+// Stable sort of the whole list in that order; every record is moved at most once
+void        SKIF_AppList_Sort                 (std::vector <std::pair <std::string, app_record_s> > *apps, int sort);
+
+// Moves a single app to where SKIF_AppList_Sort ( ) would place it, for when only its
+//   pinned state or category changed and the rest of the list is still sorted
+void        SKIF_AppList_Reposition           (std::vector <std::pair <std::string, app_record_s> > *apps, const app_record_s* app, int sort);
+
+// Identifies an app regardless of where it currently sits in the list,
+//   so unlike a pointer or an index it stays valid across re-sorts
+struct SKIF_AppHandle {
+  app_record_s::Store store = app_record_s::Store::Unspecified;
+  uint32_t            id    = 0;
+
+  bool valid (void) const { return id != 0; }
+};
+
+// Indexes a list of apps by (store, id), as well as by Epic AppName and Xbox PackageName.
+//   The list is sorted in place, so the index maps to positions that are checked on
+//     every lookup; a mismatch means the list was reordered and rebuilds the index.
+class SKIF_AppRegistry
+{
+public:
+  using apps_t =
+    std::vector <std::pair <std::string, app_record_s> >;
+
+  SKIF_AppRegistry (apps_t* apps) : _apps (apps) { };
+
+  app_record_s*  find      (app_record_s::Store store, uint32_t id);
+  app_record_s*  find      (const SKIF_AppHandle&   handle) { return find (handle.store, handle.id); }
+  app_record_s*  findEpic  (const std::string&      name_app);
+  app_record_s*  findXbox  (const std::string&      package_name);
+
+  // Looks an app up by the key used in db.json and lc.json (AppName, PackageName, or the id)
+  app_record_s*  findByKey (app_record_s::Store store, const std::string& key);
+
+  static SKIF_AppHandle
+                 handleOf  (const app_record_s* pApp) { return (pApp != nullptr) ? SKIF_AppHandle { pApp->store, pApp->id } : SKIF_AppHandle { }; }
+
+  // Must be called when the list is replaced, or when apps are added or removed
+  void           invalidate (void) { _dirty = true; }
+
+private:
+  template <typename _Key, typename _Match>
+  app_record_s*  _lookup  (const std::unordered_map <_Key, size_t>& index, const _Key& key, _Match match);
+  void           _rebuild (void);
+
+  apps_t*                                  _apps;
+  std::unordered_map <uint64_t,    size_t> _ids;  // (store << 32) | id
+  std::unordered_map <std::string, size_t> _epic; // AppName
+  std::unordered_map <std::string, size_t> _xbox; // PackageName
+  size_t                                   _size  = 0;
+  bool                                     _dirty = true;
+};
+
+// Dense array holding the few fields the library list walks every frame, so a pass
+//   over the whole list only touches the full (cold) record of rows that are drawn.
+//     Rebuilt on first use after the list was replaced, re-sorted, or invalidated.
+class SKIF_AppListView
+{
+public:
+  using apps_t =
+    SKIF_AppRegistry::apps_t;
+
+  struct entry_s {
+    std::pair <std::string, app_record_s>*
+                        app;          // The full record
+    uint32_t            id;
+    app_record_s::Store store;
+    int                 pinned;       // skif.pinned
+    uint16_t            category;     // Effective category, index into category ( )
+    bool                filtered;
+    bool                icon_pending; // tex_icon.iWorker == 1
+  };
+
+  SKIF_AppListView (apps_t* apps) : _apps (apps) { };
+
+  // Must not be called again while iterating over the returned entries
+  std::vector <entry_s>&
+                     entries    (void);
+  const std::string& category   (uint16_t index) const { return _categories [index]; }
+
+  // Must be called when the filtered state of any app changes
+  void               invalidate (void) { _dirty = true; }
+
+private:
+  void               _rebuild   (void);
+
+  apps_t*                   _apps;
+  std::vector <entry_s>     _entries;
+  std::vector <std::string> _categories;
+  const void*               _data       = nullptr;
+  size_t                    _size       = 0;
+  uint32_t                  _generation = 0;
+  bool                      _dirty      = true;
+};
@@ -0,0 +1,164 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <Windows.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+
+// Minimal binary writer/reader used by SKIF's on-disk caches (appinfo cache,
+//   library snapshot). Values are stored in native byte order, as the files
+//     never leave the machine they were written on.
+
+struct SKIF_BinaryWriter {
+  std::vector <BYTE> buf;
+
+  void raw (const void* src, size_t len)
+  {
+    buf.insert (buf.end (), (const BYTE *)src, (const BYTE *)src + len);
+  }
+
+  template <typename _T>
+  void pod (_T val) { raw (&val, sizeof (_T)); }
+
+  void str (const std::string& val)
+  {
+    pod <uint32_t> (static_cast <uint32_t> (val.size ()));
+    raw (val.data (), val.size ());
+  }
+
+  void str (const std::wstring& val)
+  {
+    pod <uint32_t> (static_cast <uint32_t> (val.size ()));
+    raw (val.data (), val.size () * sizeof (wchar_t));
+  }
+
+  // Writes to a temporary file first so a crash never leaves a half-written file behind
+  bool save (const std::wstring& path) const
+  {
+    std::error_code ec;
+    std::filesystem::create_directories (std::filesystem::path (path).parent_path (), ec);
+
+    std::wstring tmp_path = path + L".tmp";
+
+    FILE *fOut = nullptr;
+
+    _wfopen_s (&fOut, tmp_path.c_str (), L"wb");
+
+    if (fOut == nullptr)
+      return false;
+
+    bool written =
+      fwrite (buf.data (), buf.size (), 1, fOut) == 1;
+    fclose (fOut);
+
+    if (written && MoveFileExW (tmp_path.c_str (), path.c_str (), MOVEFILE_REPLACE_EXISTING))
+      return true;
+
+    DeleteFileW (tmp_path.c_str ());
+
+    return false;
+  }
+};
+
+struct SKIF_BinaryReader {
+  const BYTE* cur;
+  const BYTE* end;
+  bool        ok = true;
+
+  bool raw (void* dst, size_t len)
+  {
+    if (! ok || (size_t)(end - cur) < len)
+    {
+      ok = false;
+      return false;
+    }
+
+    memcpy (dst, cur, len);
+    cur += len;
+
+    return true;
+  }
+
+  template <typename _T>
+  _T pod (void) { _T val = { }; raw (&val, sizeof (_T)); return val; }
+
+  std::string str (void)
+  {
+    uint32_t len = pod <uint32_t> ( );
+
+    if (! ok || (size_t)(end - cur) < len)
+    {
+      ok = false;
+      return { };
+    }
+
+    std::string val ((const char *)cur, len);
+    cur += len;
+
+    return val;
+  }
+
+  std::wstring wstr (void)
+  {
+    uint32_t len = pod <uint32_t> ( );
+
+    if (! ok || (size_t)(end - cur) / sizeof (wchar_t) < len)
+    {
+      ok = false;
+      return { };
+    }
+
+    std::wstring val ((const wchar_t *)cur, len);
+    cur += len * sizeof (wchar_t);
+
+    return val;
+  }
+
+  // Reads the whole file into the buffer, which the reader then points into
+  static bool load (const std::wstring& path, std::vector <BYTE>& buffer)
+  {
+    FILE *fIn = nullptr;
+
+    _wfopen_s (&fIn, path.c_str (), L"rbS");
+
+    if (fIn == nullptr)
+      return false;
+
+    fseek  (fIn, 0, SEEK_END);
+    buffer.resize (ftell (fIn));
+    rewind (fIn);
+
+    buffer.resize (
+      fread  (buffer.data (), 1, buffer.size (), fIn)
+    );
+    fclose (fIn);
+
+    return true;
+  }
+};
@@ -4,7 +4,10 @@
 #include <string>
 #include <atomic>
 #include <memory>
+#include <set>
+#include <unordered_map>
 #include <stores/generic_library2.h>
+#include <utility/app_list.h>
 #include <nlohmann/json.hpp>
 
 // define character size
@@ -43,8 +46,17 @@ struct SKIF_GamingCollection {
       static SKIF_GamingCollection instance;
       return instance;
   }
-  static void RefreshRunningApps (std::vector <std::pair <std::string, app_record_s> > *apps);
+  static void RefreshRunningApps (std::vector <std::pair <std::string, app_record_s> > *apps, SKIF_AppRegistry* registry);
   static void SortApps (std::vector <std::pair <std::string, app_record_s> > *apps);
+
+  // Moves a single app to where SortApps ( ) would place it, for when only its pinned state
+  //   or category changed and the rest of the list is still sorted
+  static void RepositionApp (std::vector <std::pair <std::string, app_record_s> > *apps, const app_record_s* app);
+
+  // Snapshot of a processed library, used to show the list of the last session right
+  //   away on launch while the library worker repopulates it in the background
+  static bool SaveSnapshot (const std::vector <std::pair <std::string, app_record_s> > *apps, const std::set <std::string> *apptickets);
+  static bool LoadSnapshot (      std::vector <std::pair <std::string, app_record_s> > *apps,       std::set <std::string> *apptickets);
   SKIF_GamingCollection (SKIF_GamingCollection const&) = delete; // Delete copy constructor
   SKIF_GamingCollection (SKIF_GamingCollection&&)      = delete; // Delete move constructor
 
@@ -0,0 +1,38 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <vector>
+#include <utility/binary_cache.h>
+#include <stores/Steam/app_record.h>
+
+// Serialized form of a processed library, which SKIF_GamingCollection::SaveSnapshot ( )
+//   and LoadSnapshot ( ) keep on disk. flags identify the settings the list was built
+//     with; a snapshot written with different flags is rejected on load.
+
+void SKIF_LibrarySnapshot_Serialize   (SKIF_BinaryWriter& out, uint32_t flags, const std::vector <std::pair <std::string, app_record_s> > *apps, const std::set <std::string> *apptickets);
+
+// apps and apptickets are left untouched unless the whole snapshot could be read
+bool SKIF_LibrarySnapshot_Deserialize (SKIF_BinaryReader& in,  uint32_t flags,       std::vector <std::pair <std::string, app_record_s> > *apps,       std::set <std::string> *apptickets);
@@ -259,6 +259,10 @@ struct SKIF_RegistrySettings {
     SKIF_MakeRegKeyB ( LR"(SOFTWARE\Kaldaien\Special K\)",
                          LR"(Library Custom)" );
 
+  KeyValue <bool> regKVSteamAppInfoWindowed =
+    SKIF_MakeRegKeyB ( LR"(SOFTWARE\Kaldaien\Special K\)",
+                         LR"(Steam AppInfo Windowed)" );
+
 // 2023-07-31: Disabled since I believe this isn't actually used much,
 //               and the intention is to eventually have cmd line args
 //                 trigger service mode automatically when interacting
@@ -580,6 +584,7 @@ struct SKIF_RegistrySettings {
   bool bLibraryGOG              =  true;
   bool bLibraryXbox             =  true;
   bool bLibraryCustom           =  true;
+  bool bSteamAppInfoWindowed    = false; // Read appinfo.vdf through a bounded window (always on in 32-bit builds)
 
   bool bMiniMode                = false;
   bool bHorizonMode             = false; // 1038 x 325 -- covers are 186.67 x 280
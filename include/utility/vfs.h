@@ -30,7 +30,11 @@
 #include <set>
 #include <stack>
 #include <unordered_map>
+#include <unordered_set>
 #include <map>
+#include <deque>
+#include <vector>
+#include <string_view>
 
 // Steamworks API definitions
 typedef unsigned __int32 uint32;
@@ -44,6 +48,8 @@ typedef uint64 UGCHandle_t;
 
 int SK_CountWChars (const wchar_t *s, wchar_t c);
 
+// Nodes and their names are allocated from arenas owned by the SK_VirtualFS,
+//   so a rescan frees the entire tree at once through reset ( )
 class SK_VirtualFS
 {
 public:
@@ -71,170 +77,47 @@ public:
       FILETIME created;
     } time = { };
 
-    std::wstring        name   = L"";
+    const wchar_t*      name   = L""; // Interned, null-terminated
+    size_t              length =   0; // Length of name
     size_t              size   =   0;
 
     vfsNode*            parent = nullptr;
-    std::unordered_map <std::wstring, vfsNode*> children;
+    SK_VirtualFS*       vfs    = nullptr; // Owner of the arena this node lives in
+    std::vector <vfsNode*> children;      // Sorted by name
 
-    vfsNode (const wchar_t* wszName, vfsNode::type type) :
-                      name (wszName),       type_ (type)
+    vfsNode (const wchar_t* wszName, size_t len, vfsNode::type type) :
+                      name (wszName), length (len), type_ (type)
     {
     };
 
-    bool containsFile (const wchar_t* wszName)
-    {
-      if ( children.count (wszName)        != 0 &&
-                 children [wszName]->type_ == type::File )
-      {
-        return true;
-      }
+    vfsNode            (const vfsNode&) = delete;
+    vfsNode& operator= (const vfsNode&) = delete;
 
-      return false;
-    }
+    virtual ~vfsNode (void) = default;
 
-    File* addFile      (const wchar_t* wszName)
-    {
-      if (containsFile (wszName))
-        return static_cast <File *> (children [wszName]);
-
-      int dirs =
-        SK_CountWChars (wszName, L'\\') +
-        SK_CountWChars (wszName,  L'/');
-
-      vfsNode* pDir = this;
-
-      if (dirs > 0)
-      {
-        int dir = 0;
-
-        auto name_to_chop =
-          std::make_unique <wchar_t []> (
-            std::wcslen (wszName) + 1
-          );
-
-        std::wcscpy ( name_to_chop.get (),
-                        wszName );
-
-        wchar_t*  tok_ctx = nullptr;
-        wchar_t* wtok     =
-          std::wcstok (
-            name_to_chop.get (),
-              LR"(\/)",
-                &tok_ctx
-          );
-
-        while (wtok != nullptr)
-        {
-          if (++dir <= dirs)
-          {
-            auto pParent = pDir;
-
-            pDir =
-              pDir->addDirectory (wtok);
-
-            pDir->parent = pParent;
-          }
-
-          else
-          {
-            return
-              pDir->addFile (wtok);
-          }
-
-          wtok =
-            std::wcstok (nullptr, LR"(\/)", &tok_ctx);
-        }
-      }
-
-      //for ( auto& file : children )
-      //{
-      //  if ( file->type_ == type::File &&
-      //       file->name._Equal (name) )
-      //  {
-      //    return
-      //      static_cast <File *> (file);
-      //  }
-      //}
-
-      File* vfsNewFile =
-        new File (wszName);
-
-      vfsNewFile->parent = this;
-
-      children [wszName] = vfsNewFile;
-
-      return
-        vfsNewFile;
-    }
+    // Direct child by name, or nullptr
+    vfsNode* find (std::wstring_view name) const;
 
-    bool containsDirectory (const wchar_t* wszName)
+    bool containsFile (const wchar_t* wszName) const
     {
-      if ( children.count (wszName)        &&
-           children       [wszName]->type_ == type::Directory )
-      {
-        return true;
-      }
-
-      return false;
-    }
+      auto pNode = find (wszName);
 
-    Directory* addDirectory (const wchar_t* wszName)
-    {
-      if (containsDirectory (wszName))
-      {
-        return
-          static_cast <Directory *> (children [wszName]);
-      }
-
-      //for ( auto& dir : children )
-      //{
-      //  if ( dir->type_ == type::Directory &&
-      //       dir->name._Equal (name) )
-      //  {
-      //    return
-      //      static_cast <Directory *> (dir);
-      //  }
-      //}
-
-      Directory* vfsNewDir =
-        new Directory (wszName);
-
-      children [wszName] = vfsNewDir;
-      //vfsNewDir->parent = this;
-
-      return
-        vfsNewDir;
+      return pNode != nullptr && pNode->type_ == type::File;
     }
 
-    std::wstring getFullPath (void)
+    bool containsDirectory (const wchar_t* wszName) const
     {
-      SK_VirtualFS::vfsNode* pParent =
-        this;
-
-      std::stack <std::wstring> dirs;
-
-      while (pParent != nullptr)
-      {
-        dirs.push  (pParent->name);
-          pParent = pParent->parent;
-      }
-
-      std::wstring full_path;
+      auto pNode = find (wszName);
 
-      while (! dirs.empty ())
-      {
-        full_path += dirs.top ();
-                     dirs.pop ();
+      return pNode != nullptr && pNode->type_ == type::Directory;
+    }
 
-        if (! dirs.empty ())
-        {
-          full_path += LR"(\)";
-        }
-      }
+    // Path separators in wszName add the intermediate directories as well
+    File*        addFile      (const wchar_t* wszName);
+    Directory*   addDirectory (const wchar_t* wszName);
 
-      return full_path;
-    }
+    // Path relative to the root of the VFS
+    std::wstring getFullPath  (void) const;
 
     virtual void* getSubclass (REFIID iid)
     {
@@ -242,35 +125,39 @@ public:
 
       return nullptr;
     }
+
+  private:
+    vfsNode* _addChild (std::wstring_view name, vfsNode::type type);
   };
 
   class File : public vfsNode
   {
   public:
-    File (const wchar_t* name) :
-                vfsNode (name, vfsNode::type::File) { }
+    File (const wchar_t* name, size_t len) :
+                vfsNode (name, len, vfsNode::type::File) { }
   };
 
   class Directory : public vfsNode
   {
   public:
-    Directory (const wchar_t* name) :
-                     vfsNode (name, vfsNode::type::Directory) { }
+    Directory (const wchar_t* name, size_t len) :
+                     vfsNode (name, len, vfsNode::type::Directory) { }
   };
 
-  virtual ~SK_VirtualFS (void)
-  {
-    delete root;
-           root = nullptr;
-  }
+  SK_VirtualFS (void) { reset (); }
+
+  SK_VirtualFS            (const SK_VirtualFS&) = delete;
+  SK_VirtualFS& operator= (const SK_VirtualFS&) = delete;
+
+  virtual ~SK_VirtualFS (void) = default;
+
+  // Frees every node and name at once and starts over with an empty root
+  void reset (void);
 
   // Resets the virtual filesystem
   virtual void clear (void)
   {
-    delete root;
-           root =
-    new Directory (L"( VFS Root )");
-           name =  L"Uninitialized VFS";
+    reset ();
   }
 
   operator vfsNode* (void) { return root; };
@@ -278,8 +165,17 @@ public:
 protected:
   std::wstring name = L"Uninitialized VFS";
 
-  vfsNode*     root =
-    new Directory (L"( VFS Root )");
+  vfsNode*     root = nullptr;
 
 private:
-};
\ No newline at end of file
+  const wchar_t* _intern (std::wstring_view name);
+
+  // std::deque never moves its elements, so nodes keep stable addresses
+  std::deque <File>                         _files;
+  std::deque <Directory>                    _dirs;
+
+  std::vector <std::unique_ptr <wchar_t []>> _name_blocks;
+  size_t                                    _name_used     = 0;
+  size_t                                    _name_capacity = 0;
+  std::unordered_set <std::wstring_view>    _names;
+};
@@ -1440,10 +1440,6 @@ wWinMain ( _In_     HINSTANCE hInstance,
   extern   CRITICAL_SECTION   CriticalSectionDbgHelp;
   InitializeCriticalSection (&CriticalSectionDbgHelp);
 
-  // Initialize
-  extern   CRITICAL_SECTION   VFSManifestSection;
-  InitializeCriticalSection (&VFSManifestSection);
-
   if (StrStrIW (lpCmdLine, L"ResetOverlayMode") != NULL)
   {
     if (::IsUserAnAdmin ( ))
@@ -4742,6 +4738,7 @@ SKIF_WndProc (HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
       break;
 
     case WM_SKIF_ICON:
+    case WM_SKIF_APPINFO:
       addAdditionalFrames += 3;
       break;
 
@@ -127,10 +127,7 @@ SKIF_GOG_GetInstalledAppIDs (std::vector <std::pair < std::string, app_record_s
                   record.specialk.profile_dir_utf8         = SK_WideCharToUTF8(record.specialk.profile_dir);
                   record.specialk.injection.injection.type = InjectionType::Global;
 
-                  std::pair <std::string, app_record_s>
-                    GOG(record.names.normal, record);
-
-                  apps->emplace_back(GOG);
+                  apps->emplace_back (record.names.normal, std::move (record));
 
                   dwRead++;
                 }
@@ -243,10 +243,7 @@ void SKIF_GetCustomAppIDs (std::vector<std::pair<std::string, app_record_s>>* ap
                 record.specialk.profile_dir_utf8         = SK_WideCharToUTF8(record.specialk.profile_dir);
                 record.specialk.injection.injection.type = InjectionType::Global;
 
-                std::pair <std::string, app_record_s>
-                  pair (record.names.normal, record);
-
-                apps->emplace_back (pair);
+                apps->emplace_back (record.names.normal, std::move (record));
               }
             }
 
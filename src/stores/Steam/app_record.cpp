@@ -462,6 +462,14 @@ app_branch_record_s::getDescriptionUTF8 (void)
   return description_utf8;
 }
 
+// The parent of each branch still points at this record, as the copy is moved
+//   to wherever it ends up the caller has to update them there (see publishApps)
+app_record_s
+app_record_s::clone (void) const
+{
+  return app_record_s (*this);
+}
+
 DWORD app_record_s::client_state_s::_TimeLastNotified = 0UL;
 
 
@@ -0,0 +1,497 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <stores/Steam/keyvalues.h>
+#include <plog/Log.h>
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <intrin.h>
+
+static int
+SK_Steam_KeyValueTree_Compare (std::string_view lhs, std::string_view rhs)
+{
+  const size_t len =
+    std::min (lhs.size (), rhs.size ());
+
+  for (size_t i = 0; i < len; ++i)
+  {
+    const int l = tolower (static_cast <unsigned char> (lhs [i])),
+              r = tolower (static_cast <unsigned char> (rhs [i]));
+
+    if (l != r)
+      return l - r;
+  }
+
+  return (lhs.size () < rhs.size ()) ? -1 :
+         (lhs.size () > rhs.size ()) ?  1 : 0;
+}
+
+// FNV-1a over the ASCII case-folded key
+static uint32_t
+SK_Steam_KeyValueTree_Hash (std::string_view key)
+{
+  uint32_t hash = 0x811C9DC5;
+
+  for (char c : key)
+  {
+    hash ^= static_cast <uint32_t> (tolower (static_cast <unsigned char> (c)));
+    hash *= 0x01000193;
+  }
+
+  return hash;
+}
+
+static size_t
+SK_Steam_KeyValueTree_Slot (uint32_t parent, uint32_t hash, size_t mask)
+{
+  return (hash ^ (parent * 0x9E3779B1)) & mask;
+}
+
+// Quoted strings make up nearly all of a KeyValues file, so their bodies are
+//   scanned 16 bytes at a time. Most keys and values are shorter than that, so
+//     a 32 byte (AVX2) scan measured no faster and is not worth a CPUID check.
+size_t
+SK_Steam_KeyValues_FindQuote (std::string_view input, size_t pos)
+{
+  const char*  data = input.data ();
+  const size_t len  = input.size ();
+
+  unsigned long idx = 0;
+
+  const __m128i quote16 = _mm_set1_epi8 ('"'),
+                slash16 = _mm_set1_epi8 ('\\');
+
+  for (; pos + 16 <= len; pos += 16)
+  {
+    const __m128i chunk =
+      _mm_loadu_si128 (reinterpret_cast <const __m128i *> (data + pos));
+
+    const unsigned long mask =
+      static_cast <unsigned long> (
+        _mm_movemask_epi8 (
+          _mm_or_si128 ( _mm_cmpeq_epi8 (chunk, quote16),
+                         _mm_cmpeq_epi8 (chunk, slash16) )
+        )
+      );
+
+    if (_BitScanForward (&idx, mask))
+      return pos + idx;
+  }
+
+  return
+    SK_Steam_KeyValues_FindQuoteScalar (input, pos);
+}
+
+size_t
+SK_Steam_KeyValues_FindQuoteScalar (std::string_view input, size_t pos)
+{
+  const char*  data = input.data ();
+  const size_t len  = input.size ();
+
+  while (pos < len && data [pos] != '"' && data [pos] != '\\')
+    ++pos;
+
+  return pos;
+}
+
+SK_Steam_KeyValueReader::_Token
+SK_Steam_KeyValueReader::_next (void)
+{
+  const size_t len = _input.size ();
+
+  while (_pos < len)
+  {
+    const char c = _input [_pos];
+
+    // Comments
+    if (c == '/' && _pos + 1 < len && _input [_pos + 1] == '/')
+    {
+      const size_t eol =
+        _input.find ('\n', _pos);
+
+      _pos = (eol != std::string_view::npos) ? eol : len;
+    }
+
+    // Conditionals, e.g. [$WIN32]
+    else if (c == '[')
+    {
+      while (_pos < len && _input [_pos] != ']')
+        ++_pos;
+      ++_pos;
+    }
+
+    else if (c == '\0' || isspace (static_cast <unsigned char> (c)))
+      ++_pos;
+
+    else
+      break;
+  }
+
+  if (_pos >= len)
+    return _Token::End;
+
+  _token.clear ();
+
+  switch (_input [_pos])
+  {
+    case '{': ++_pos; return _Token::Open;
+    case '}': ++_pos; return _Token::Close;
+
+    case '"':
+      for (++_pos; _pos < len; )
+      {
+        const size_t stop =
+          SK_Steam_KeyValues_FindQuote (_input, _pos);
+
+        _token.append (_input.data () + _pos, stop - _pos);
+        _pos = stop;
+
+        if (_pos >= len || _input [_pos] == '"')
+          break;
+
+        // Escape sequence
+        if (_pos + 1 < len)
+        {
+          switch (_input [_pos + 1])
+          {
+            case '\\': _token += '\\'; _pos += 2; continue;
+            case '"':  _token += '"';  _pos += 2; continue;
+            case 'n':  _token += '\n'; _pos += 2; continue;
+            case 't':  _token += '\t'; _pos += 2; continue;
+          }
+        }
+
+        _token += '\\';
+        ++_pos;
+      }
+
+      ++_pos; // Closing quote
+      return _Token::String;
+  }
+
+  // Unquoted token
+  while (_pos < len && _input [_pos] != '"' && _input [_pos] != '{' && _input [_pos] != '}' &&
+         ! isspace (static_cast <unsigned char> (_input [_pos])))
+    _token += _input [_pos++];
+
+  return _Token::String;
+}
+
+SK_Steam_KeyValueReader::Event
+SK_Steam_KeyValueReader::next (void)
+{
+  bool has_key = false;
+
+  for (_Token tok = _next (); tok != _Token::End; tok = _next ())
+  {
+    switch (tok)
+    {
+      case _Token::String:
+        if (! has_key)
+        {
+          std::swap (_key, _token);
+          has_key = true;
+          break;
+        }
+
+        std::swap (_value, _token);
+        return Event::KeyValue;
+
+      case _Token::Open:
+        if (! has_key)
+          _key.clear ();
+
+        ++_depth;
+        return Event::SectionBegin;
+
+      case _Token::Close:
+        // A key lacking a value is dropped, as is a } lacking a matching {
+        if (_depth > 0)
+        {
+          --_depth;
+          return Event::SectionEnd;
+        }
+
+        PLOG_WARNING << "Unbalanced } in KeyValues data, ignoring it...";
+        has_key = false;
+        break;
+    }
+  }
+
+  // Sections still open at this point are implicitly closed
+  return Event::End;
+}
+
+SK_Steam_KeyValueQuery::SK_Steam_KeyValueQuery (std::initializer_list <std::string_view> patterns)
+{
+  for (auto& pattern : patterns)
+  {
+    auto& components =
+      _patterns.emplace_back ();
+
+    for (size_t begin = 0; begin <= pattern.size (); )
+    {
+      size_t end =
+        pattern.find ('/', begin);
+
+      if (end == std::string_view::npos)
+          end = pattern.size ();
+
+      components.emplace_back (pattern.substr (begin, end - begin));
+
+      begin = end + 1;
+    }
+  }
+
+  assert (_patterns.size () <= 64);
+}
+
+std::vector <SK_Steam_KeyValueQuery::match_s>
+SK_Steam_KeyValueQuery::run (std::string_view input) const
+{
+  std::vector <match_s> matches;
+
+  const auto _matches = [&](size_t pattern, size_t depth, const std::string& key)
+  {
+    const auto& component =
+      _patterns [pattern][depth];
+
+    return component == "*" || SK_Steam_KeyValueTree_Compare (component, key) == 0;
+  };
+
+  // Patterns whose prefix matches the currently open sections, one mask per depth
+  std::vector <uint64_t>    alive = { (_patterns.size () < 64) ? (1ULL << _patterns.size ()) - 1
+                                                               : ~0ULL };
+  std::vector <std::string> path;
+
+  SK_Steam_KeyValueReader reader (input);
+
+  for ( auto event  = reader.next ( );
+             event != SK_Steam_KeyValueReader::Event::End;
+             event  = reader.next ( ) )
+  {
+    const size_t depth = path.size ();
+
+    switch (event)
+    {
+      case SK_Steam_KeyValueReader::Event::SectionBegin:
+      {
+        uint64_t mask = 0;
+
+        for (size_t p = 0; p < _patterns.size (); ++p)
+        {
+          if ((alive.back () & (1ULL << p)) && _patterns [p].size () > depth + 1 && _matches (p, depth, reader.key ()))
+            mask |= (1ULL << p);
+        }
+
+        alive.push_back (mask);
+        path .push_back (reader.key ());
+        break;
+      }
+
+      case SK_Steam_KeyValueReader::Event::SectionEnd:
+        alive.pop_back ();
+        path .pop_back ();
+        break;
+
+      case SK_Steam_KeyValueReader::Event::KeyValue:
+        if (alive.back () == 0)
+          break;
+
+        for (size_t p = 0; p < _patterns.size (); ++p)
+        {
+          if ((alive.back () & (1ULL << p)) && _patterns [p].size () == depth + 1 && _matches (p, depth, reader.key ()))
+          {
+            match_s& match = matches.emplace_back ();
+            match.pattern  = p;
+            match.value    = reader.value ();
+
+            for (size_t i = 0; i <= depth; ++i)
+            {
+              if (_patterns [p][i] == "*")
+                match.captures.push_back (i < depth ? path [i] : reader.key ());
+            }
+          }
+        }
+        break;
+    }
+  }
+
+  return matches;
+}
+
+void
+SK_Steam_KeyValueTree::parse (std::string_view input)
+{
+  nodes.clear ();
+  index.clear ();
+
+  nodes.emplace_back ();
+  nodes [0].section = true;
+
+  struct open_s {
+    uint32_t node;
+    uint32_t last = npos; // Last child added, to link up the next one
+  };
+
+  std::vector <open_s> open = { { 0 } };
+
+  const auto _append = [&](node_s&& node) -> uint32_t
+  {
+    const uint32_t idx =
+      static_cast <uint32_t> (nodes.size ());
+
+    auto& parent = open.back ();
+
+    if (parent.last == npos)
+      nodes [parent.node].first = idx;
+    else
+      nodes [parent.last].next  = idx;
+
+    parent.last = idx;
+    nodes [parent.node].count++;
+
+    node.parent = parent.node;
+    node.hash   = SK_Steam_KeyValueTree_Hash (node.key);
+
+    nodes.emplace_back (std::move (node));
+
+    return idx;
+  };
+
+  SK_Steam_KeyValueReader reader (input);
+
+  for ( auto event  = reader.next ( );
+             event != SK_Steam_KeyValueReader::Event::End;
+             event  = reader.next ( ) )
+  {
+    switch (event)
+    {
+      case SK_Steam_KeyValueReader::Event::KeyValue:
+      {
+        node_s            node;
+        node.key   = reader.key   ();
+        node.value = reader.value ();
+        _append (std::move (node));
+        break;
+      }
+
+      case SK_Steam_KeyValueReader::Event::SectionBegin:
+      {
+        node_s            node;
+        node.key     = reader.key ();
+        node.section = true;
+
+        open.push_back ({ _append (std::move (node)) });
+        break;
+      }
+
+      case SK_Steam_KeyValueReader::Event::SectionEnd:
+        open.pop_back ();
+        break;
+    }
+  }
+
+  // Inserted in file order, so the first of any duplicate keys is found first
+  size_t slots = 16;
+
+  while (slots < nodes.size () * 2)
+         slots <<= 1;
+
+  index.assign (slots, npos);
+
+  const size_t mask = slots - 1;
+
+  for (uint32_t idx = 1; idx < nodes.size (); ++idx)
+  {
+    size_t slot =
+      SK_Steam_KeyValueTree_Slot (nodes [idx].parent, nodes [idx].hash, mask);
+
+    while (index [slot] != npos)
+      slot = (slot + 1) & mask;
+
+    index [slot] = idx;
+  }
+}
+
+uint32_t
+SK_Steam_KeyValueTree::find (uint32_t section, std::string_view key) const
+{
+  if (section >= nodes.size () || ! nodes [section].section || index.empty ())
+    return npos;
+
+  const uint32_t hash = SK_Steam_KeyValueTree_Hash (key);
+  const size_t   mask = index.size () - 1;
+
+  for ( size_t slot  = SK_Steam_KeyValueTree_Slot (section, hash, mask);
+        index [slot] != npos;
+               slot  = (slot + 1) & mask )
+  {
+    const node_s& node =
+      nodes [index [slot]];
+
+    if (node.parent == section && node.hash == hash &&
+        SK_Steam_KeyValueTree_Compare (node.key, key) == 0)
+      return index [slot];
+  }
+
+  return npos;
+}
+
+uint32_t
+SK_Steam_KeyValueTree::find (uint32_t section, uint64_t numeric_key) const
+{
+  char                      szKey [24] = { };
+  auto [end, ec] =
+    std::to_chars (szKey, szKey + sizeof (szKey), numeric_key);
+
+  return
+    find (section, std::string_view (szKey, end - szKey));
+}
+
+uint32_t
+SK_Steam_KeyValueTree::find (std::initializer_list <std::string_view> path) const
+{
+  uint32_t node = 0;
+
+  for (auto& key : path)
+  {
+    if ((node = find (node, key)) == npos)
+      break;
+  }
+
+  return node;
+}
+
+const std::string&
+SK_Steam_KeyValueTree::getValue (std::initializer_list <std::string_view> path) const
+{
+  static const std::string empty;
+
+  const uint32_t node =
+    find (path);
+
+  return (node != npos && ! nodes [node].section) ? nodes [node].value
+                                                  : empty;
+}
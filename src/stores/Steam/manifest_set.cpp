@@ -0,0 +1,128 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <stores/Steam/manifest_set.h>
+
+#include <cwctype>
+
+static bool
+SK_Steam_ManifestSet_EqualsNoCase (std::wstring_view lhs, std::wstring_view rhs)
+{
+  if (lhs.size () != rhs.size ())
+    return false;
+
+  for (size_t i = 0; i < lhs.size (); ++i)
+  {
+    if (towlower (lhs [i]) != towlower (rhs [i]))
+      return false;
+  }
+
+  return true;
+}
+
+// NTFS names are case-insensitive, so Steam may report the same manifest in
+//   different cases between a listing and a change event
+static std::wstring
+SK_Steam_ManifestSet_Fold (std::wstring_view name)
+{
+  std::wstring folded (name);
+
+  for (auto& ch : folded)
+    ch = static_cast <wchar_t> (towlower (ch));
+
+  return folded;
+}
+
+bool
+SK_Steam_ManifestSet::isManifestName (std::wstring_view name)
+{
+  static constexpr std::wstring_view prefix = L"appmanifest_",
+                                     suffix = L".acf";
+
+  return name.size () > prefix.size () + suffix.size () &&
+    SK_Steam_ManifestSet_EqualsNoCase (name.substr (0,                             prefix.size ()), prefix) &&
+    SK_Steam_ManifestSet_EqualsNoCase (name.substr (name.size () - suffix.size (), suffix.size ()), suffix);
+}
+
+uint32_t
+SK_Steam_ManifestSet::appidOf (std::wstring_view name)
+{
+  static constexpr size_t prefix = std::wstring_view (L"appmanifest_").size (),
+                          suffix = std::wstring_view (L".acf"        ).size ();
+
+  if (! isManifestName (name))
+    return 0;
+
+  uint64_t appid = 0;
+
+  for (auto ch : name.substr (prefix, name.size () - prefix - suffix))
+  {
+    if (ch < L'0' || ch > L'9')
+      return 0;
+
+    appid = appid * 10 + static_cast <uint64_t> (ch - L'0');
+
+    if (appid > UINT32_MAX)
+      return 0;
+  }
+
+  return static_cast <uint32_t> (appid);
+}
+
+void
+SK_Steam_ManifestSet::scan (const std::vector <std::wstring>& names)
+{
+  files.clear ();
+
+  for (auto& name : names)
+  {
+    if (isManifestName (name))
+      files.insert (SK_Steam_ManifestSet_Fold (name));
+  }
+
+  rescan = false;
+}
+
+bool
+SK_Steam_ManifestSet::apply (const std::vector <change_s>& changes)
+{
+  bool modified = false;
+
+  for (auto& change : changes)
+  {
+    if (change.action == change_s::Action::Overflow)
+    {
+      rescan = true;
+      continue;
+    }
+
+    if (! isManifestName (change.name))
+      continue;
+
+    if (change.action == change_s::Action::Added)
+      modified |= files.insert (SK_Steam_ManifestSet_Fold (change.name)).second;
+    else
+      modified |= files.erase  (SK_Steam_ManifestSet_Fold (change.name)) != 0;
+  }
+
+  return modified;
+}
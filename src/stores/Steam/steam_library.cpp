@@ -21,14 +21,18 @@
 //
 
 #include <stores/steam/steam_library.h>
+#include <SKIF.h>
 #include <utility/registry.h>
 #include <utility/utility.h>
 #include <stores/Steam/apps_ignore.h>
-#include <vdf_parser.hpp>
 #include <utility/fsutil.h>
 #include <stores/Steam/vdf.h>
 
 #include <fstream>
+#include <charconv>
+#include <intrin.h>
+#include <process.h>
+#include <mutex>
 #include <filesystem>
 #include <regex>
 #include <utility/injection.h>
@@ -48,30 +52,240 @@ std::atomic<bool> g_SteamLibrariesParsed = false;
 
 extern std::atomic<int> SKIF_FrameCount;
 
-CRITICAL_SECTION VFSManifestSection;
-
-// Thread safety is backed by the VFSManifestSection critical section
-struct {
-  int                 frame_last_scanned = 0; // 0 == not initialized nor scanned
-  SKIF_DirectoryWatch watch;
-  SK_VirtualFS        manifest_vfs;
-  DWORD               signaled = 0;
-  int                 count    = 0;
-  wchar_t             path [MAX_PATH + 2] = { };
-  UINT_PTR            timer;
+// Watches a steamapps folder through ReadDirectoryChangesW, which unlike
+//   FindFirstChangeNotification reports which files were added or removed
+struct SK_Steam_LibraryWatch
+{
+  HANDLE     hDirectory = INVALID_HANDLE_VALUE;
+  OVERLAPPED overlapped = { };
+  bool       pending    = false;
+
+  alignas (DWORD)
+  BYTE       buffer [16384] = { };
+
+  ~SK_Steam_LibraryWatch (void)
+  {
+    if (hDirectory != INVALID_HANDLE_VALUE)
+    {
+      CancelIo    (hDirectory);
+      CloseHandle (hDirectory);
+    }
+
+    if (overlapped.hEvent != nullptr)
+      CloseHandle (overlapped.hEvent);
+  }
+
+  bool active (void) const { return pending; }
+  bool queued (void) const { return pending && HasOverlappedIoCompleted (&overlapped); } // Events that have yet to be polled
+
+  bool start (const wchar_t* wszPath)
+  {
+    if (hDirectory == INVALID_HANDLE_VALUE)
+    {
+      hDirectory =
+        CreateFileW ( wszPath, FILE_LIST_DIRECTORY,
+                        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                          nullptr, OPEN_EXISTING,
+                            FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+                              nullptr );
+
+      if (hDirectory == INVALID_HANDLE_VALUE)
+        return false;
+
+      overlapped.hEvent =
+        CreateEvent (nullptr, TRUE, FALSE, nullptr);
+    }
+
+    if (! pending && overlapped.hEvent != nullptr)
+    {
+      ResetEvent (overlapped.hEvent);
+
+      pending =
+        ReadDirectoryChangesW ( hDirectory, buffer, sizeof (buffer), FALSE,
+                                  FILE_NOTIFY_CHANGE_FILE_NAME, nullptr, &overlapped, nullptr );
+
+      if (! pending)
+        PLOG_ERROR << "Failed to watch " << std::wstring (wszPath) << ", error: " << GetLastError ( );
+    }
+
+    return pending;
+  }
+
+  // Collects the changes reported since the last call, returns true if there were any
+  bool poll (const wchar_t* wszPath, std::vector <SK_Steam_ManifestSet::change_s>& changes)
+  {
+    using Action = SK_Steam_ManifestSet::change_s::Action;
+
+    if (! pending)
+      return false;
+
+    DWORD dwBytes = 0;
+
+    if (! GetOverlappedResult (hDirectory, &overlapped, &dwBytes, FALSE))
+    {
+      if (GetLastError ( ) == ERROR_IO_INCOMPLETE)
+        return false;
+
+      dwBytes = 0; // e.g. ERROR_NOTIFY_ENUM_DIR
+    }
+
+    pending = false;
+
+    // The buffer overflowed, so individual changes were lost
+    if (dwBytes == 0)
+      changes.push_back ({ Action::Overflow });
+
+    else
+    {
+      for (BYTE* pEntry = buffer; ; )
+      {
+        auto pInfo =
+          reinterpret_cast <FILE_NOTIFY_INFORMATION *> (pEntry);
+
+        std::wstring name (pInfo->FileName, pInfo->FileNameLength / sizeof (wchar_t));
+
+        switch (pInfo->Action)
+        {
+          case FILE_ACTION_ADDED:
+          case FILE_ACTION_RENAMED_NEW_NAME:
+            changes.push_back ({ Action::Added,   std::move (name) });
+            break;
+          case FILE_ACTION_REMOVED:
+          case FILE_ACTION_RENAMED_OLD_NAME:
+            changes.push_back ({ Action::Removed, std::move (name) });
+            break;
+        }
+
+        if (pInfo->NextEntryOffset == 0)
+          break;
+
+        pEntry += pInfo->NextEntryOffset;
+      }
+    }
+
+    start (wszPath);
+
+    return true;
+  }
+};
+
+// Immutable list of the appmanifest files in a library, published whenever
+//   the manifest set changes so readers never have to lock the library
+struct SK_Steam_LibraryManifests
+{
+  std::wstring          path;   // steamapps folder
+  std::vector <AppId_t> appids; // In the order of the file names
+};
+
+struct SK_Steam_Library
+{
+  // Guards everything but the published manifests; each library is
+  //   scanned on its own thread, so there is no lock shared between them
+  std::mutex            mutex;
+
+  int                   frame_last_scanned = 0; // 0 == not initialized nor scanned
+  SK_Steam_LibraryWatch watch;
+  SK_Steam_ManifestSet  manifests;
+  DWORD                 signaled = 0;
+  bool                  changed  = false; // Manifests were added or removed since the last signal
+  wchar_t               path [MAX_PATH + 2] = { };
+  UINT_PTR              timer;
+
+  std::atomic <std::shared_ptr <const SK_Steam_LibraryManifests>>
+                        published;
+
+  bool                  publish (void); // Returns true if the list differs from the previous one
 } static steam_libraries[MAX_STEAM_LIBRARIES];
 
-// Helper function used to perform a case insensitive search of tyti::vdf::objects
-static std::shared_ptr <tyti::vdf::object>
-SKIF_VDF_ciSearch (const std::string value, const std::unordered_map <std::string, std::shared_ptr<tyti::vdf::object>>* map)
+// Names of the files in a steamapps folder that may be appmanifests
+static std::vector <std::wstring>
+SK_Steam_ListManifests (wchar_t* wszPath)
 {
-  for (auto& child : *map)
+  SK_VirtualFS vfs;
+
+  SK_VFS_ScanTree ( vfs, wszPath, L"appmanifest_*.acf", 0);
+
+  std::vector <std::wstring> names;
+
+  // SK_VFS_ScanTree adds the files under a directory named after the full path
+  SK_VirtualFS::vfsNode* pFolder =
+    vfs;
+
+  for (const auto& folder : pFolder->children)
   {
-    if (lstrcmpiA (child.first.c_str(), value.c_str()) == 0)
-      return child.second;
+    for (const auto& file : folder->children)
+      names.emplace_back (file->name, file->length);
   }
 
-  return nullptr;
+  return names;
+}
+
+bool
+SK_Steam_Library::publish (void)
+{
+  auto snapshot =
+    std::make_shared <SK_Steam_LibraryManifests> ();
+
+  snapshot->path = path;
+  snapshot->appids.reserve (manifests.files.size ());
+
+  for (const auto& file : manifests.files)
+  {
+    uint32_t appid =
+      SK_Steam_ManifestSet::appidOf (file);
+
+    if (appid != 0)
+      snapshot->appids.push_back (appid);
+  }
+
+  auto previous =
+    published.load ();
+
+  const bool differs =
+    (previous == nullptr || previous->appids != snapshot->appids);
+
+  published.store (std::move (snapshot));
+
+  return differs;
+}
+
+// Applies any pending change events to the library, its mutex must be held.
+//   Only ever called on the UI thread, as a pending ReadDirectoryChangesW is
+//     cancelled when the thread that issued it exits. Returns true if there were any events.
+static bool
+SK_Steam_UpdateLibraryManifests (SK_Steam_Library& library)
+{
+  bool events   = false,
+       modified = false;
+
+  std::vector <SK_Steam_ManifestSet::change_s> changes;
+
+  // Rescan once the watch is up, so anything that changed since an earlier scan is not missed
+  if (! library.watch.active ())
+  {
+    if (library.watch.start (library.path))
+      library.manifests.rescan = true;
+  }
+
+  else if (library.watch.poll (library.path, changes))
+  {
+    if (library.manifests.apply (changes))
+      modified = true;
+
+    library.signaled = SKIF_Util_timeGetTime ( );
+    events           = true;
+  }
+
+  if (library.manifests.rescan)
+  {
+    library.manifests.scan (SK_Steam_ListManifests (library.path));
+    modified = true;
+  }
+
+  if (modified && library.publish ( ))
+    library.changed = true;
+
+  return events;
 }
 
 int
@@ -149,20 +363,66 @@ SK_VFS_ScanTree ( SK_VirtualFS::vfsNode* pVFSRoot,
   return found;
 }
 
+// Reads an appmanifest file into the record
+static bool
+SK_Steam_ReadManifest (const wchar_t *wszManifestFullPath, app_record_s *app)
+{
+  // When opening an existing file, the CreateFile function performs the following actions:
+  // [...] and ignores any file attributes (FILE_ATTRIBUTE_*) specified by dwFlagsAndAttributes.
+  CHandle hManifest (
+    CreateFileW ( wszManifestFullPath,
+                    GENERIC_READ,
+                      FILE_SHARE_READ | FILE_SHARE_WRITE,
+                        nullptr,        OPEN_EXISTING,
+                          FILE_ATTRIBUTE_NORMAL, // GetFileAttributesW (wszManifestFullPath)
+                            nullptr ) );
+
+  if (hManifest != INVALID_HANDLE_VALUE)
+  {
+    //PLOG_VERBOSE << "Reading " << wszManifest;
+
+    DWORD dwSizeHigh = 0,
+          dwRead     = 0,
+          dwSize     =
+      GetFileSize (hManifest, &dwSizeHigh);
+
+    auto szManifestData =
+      std::make_unique <char []> (
+        std::size_t (dwSize) + std::size_t (1)
+      );
+    auto manifest_data =
+      szManifestData.get ();
+
+    if (! manifest_data)
+      return false;
+
+    const bool bRead =
+      ReadFile ( hManifest,
+                    manifest_data,
+                      dwSize,
+                    &dwRead,
+                        nullptr );
+
+    if (bRead && dwRead)
+    {
+      app->steam.manifest_data = manifest_data;
+      app->steam.manifest_path = wszManifestFullPath;
+      return true;
+    }
+  }
+
+  return false;
+}
+
 std::string
 SK_GetManifestContentsForAppID (app_record_s *app)
 {
   //PLOG_VERBOSE << "Steam AppID: " << appid;
 
-  static AppId_t     manifest_id = 0;
-  static std::string manifest;
-  
+  // No function-level cache here, this gets called from the appinfo workers
   if (! app->steam.manifest_data.empty())
     return app->steam.manifest_data;
 
-  if (manifest_id == app->id && (! manifest.empty ()))
-    return manifest;
-
   steam_library_t* steam_lib_paths = nullptr;
   int              steam_libs      = SK_Steam_GetLibraries (&steam_lib_paths);
 
@@ -174,92 +434,27 @@ SK_GetManifestContentsForAppID (app_record_s *app)
     bool found = false;
     wchar_t    wszManifestFullPath [MAX_PATH + 2] = { };
 
-    EnterCriticalSection (&VFSManifestSection);
-
     for (int i = 0; i < steam_libs; i++)
     {
-      auto& library =
-        steam_libraries[i];
+      auto manifests =
+        steam_libraries[i].published.load ();
 
-      SK_VirtualFS::vfsNode* pFolder =
-        library.manifest_vfs;
+      if (manifests == nullptr)
+        continue;
 
-      wchar_t    wszManifest [MAX_PATH + 2] = { };
-      swprintf ( wszManifest, MAX_PATH,
-                   LR"(appmanifest_%u.acf)",
-                            app->id );
-      
-      // This will really only iterate once, over [0]...
-      for (const auto& folder : pFolder->children)
+      if (std::find (manifests->appids.begin (), manifests->appids.end (), app->id) != manifests->appids.end ())
       {
-        if (folder.second->containsFile (wszManifest))
-        {
-          auto* file =
-            folder.second->children[wszManifest];
-
-          wcsncpy_s (wszManifestFullPath,  MAX_PATH,
-             file->getFullPath().c_str(), _TRUNCATE
-          );
-          
-          found = true;
-          break;
-        }
-      }
+        swprintf ( wszManifestFullPath, MAX_PATH,
+                     LR"(%s\appmanifest_%u.acf)",
+                       manifests->path.c_str (), app->id );
 
-      if (found)
+        found = true;
         break;
-    }
-
-    LeaveCriticalSection (&VFSManifestSection);
-
-    // When opening an existing file, the CreateFile function performs the following actions:
-    // [...] and ignores any file attributes (FILE_ATTRIBUTE_*) specified by dwFlagsAndAttributes.
-    CHandle hManifest (
-      CreateFileW ( wszManifestFullPath,
-                      GENERIC_READ,
-                        FILE_SHARE_READ | FILE_SHARE_WRITE,
-                          nullptr,        OPEN_EXISTING,
-                            FILE_ATTRIBUTE_NORMAL, // GetFileAttributesW (wszManifestFullPath)
-                              nullptr ) );
-
-    if (hManifest != INVALID_HANDLE_VALUE)
-    {
-      //PLOG_VERBOSE << "Reading " << wszManifest;
-
-      DWORD dwSizeHigh = 0,
-            dwRead     = 0,
-            dwSize     =
-        GetFileSize (hManifest, &dwSizeHigh);
-
-      auto szManifestData =
-        std::make_unique <char []> (
-          std::size_t (dwSize) + std::size_t (1)
-        );
-      auto manifest_data =
-        szManifestData.get ();
-
-      if (! manifest_data)
-        return "";
-
-      const bool bRead =
-        ReadFile ( hManifest,
-                      manifest_data,
-                        dwSize,
-                      &dwRead,
-                          nullptr );
-
-      if (bRead && dwRead)
-      {
-        manifest =
-          std::move (manifest_data);
-
-        manifest_id = app->id;
-
-        app->steam.manifest_data = manifest;
-        app->steam.manifest_path = wszManifestFullPath;
-        return app->steam.manifest_data;
       }
     }
+
+    if (found && SK_Steam_ReadManifest (wszManifestFullPath, app))
+      return app->steam.manifest_data;
   }
 
   app->steam.manifest_data =  "<InvalidData>";
@@ -268,6 +463,22 @@ SK_GetManifestContentsForAppID (app_record_s *app)
   return "";
 }
 
+const SK_Steam_KeyValueTree*
+SK_GetManifestForAppID (app_record_s *app)
+{
+  // Parsed once, all of the SK_UseManifestToGet* helpers query the same tree
+  if (app->steam.manifest_kv == nullptr)
+  {
+    if (SK_GetManifestContentsForAppID (app).empty ())
+      return nullptr;
+
+    app->steam.manifest_kv =
+      std::make_shared <SK_Steam_KeyValueTree> (app->steam.manifest_data);
+  }
+
+  return app->steam.manifest_kv.get ();
+}
+
 
 std::string
 SKIF_Steam_GetUserConfigStore (SteamId3_t userid, ConfigStore config)
@@ -488,34 +699,32 @@ SK_Steam_GetLibraries (steam_library_t** ppLibraries)
         {
           data [dwSize] = '\0';
 
-          for (int i = 1; i < MAX_STEAM_LIBRARIES - 1; i++)
+          // Old libraryfolders.vdf format, and the new (July 2021) one
+          static const SK_Steam_KeyValueQuery
+            library_folders ({ "LibraryFolders/*", "LibraryFolders/*/path" });
+
+          for (auto& match : library_folders.run ({ data, dwRead }))
           {
-            // Old libraryfolders.vdf format
-            std::wstring lib_path =
-              SK_Steam_KeyValues::getValueAsUTF16 (
-                data, { "LibraryFolders" }, std::to_string (i)
-              );
+            const std::string& idx =
+              match.captures.front ();
 
-            if (lib_path.empty ())
-            {
-              // New (July 2021) libraryfolders.vdf format
-              lib_path =
-                SK_Steam_KeyValues::getValueAsUTF16 (
-                  data, { "LibraryFolders", std::to_string (i) }, "path"
-                );
-            }
+            // 0 is the default Steam library (added below), and the old format
+            //   also holds non-numeric keys such as ContentStatsID
+            if (idx.empty () || idx == "0" || idx.find_first_not_of ("0123456789") != std::string::npos)
+              continue;
+
+            if (steam_libs >= MAX_STEAM_LIBRARIES - 2)
+              break;
+
+            std::wstring lib_path =
+              SKIF_Util_NormalizeFullPath (SK_UTF8ToWideChar (match.value));
 
             if (! lib_path.empty ())
             {
-              lib_path = SKIF_Util_NormalizeFullPath (lib_path);
-
               wcsncpy_s (
                 (wchar_t *)steam_lib_paths [steam_libs++], MAX_PATH,
                                  lib_path.c_str (),       _TRUNCATE );
             }
-
-            else
-              break;
           }
         }
       }
@@ -543,24 +752,8 @@ SK_UseManifestToGetAppName (app_record_s *app)
 {
   //PLOG_VERBOSE << "Steam AppID: " << appid;
 
-  if (app->steam.manifest_data.empty())
-      app->steam.manifest_data =
-        SK_GetManifestContentsForAppID (app);
-
-  if (! app->steam.manifest_data.empty ())
-  {
-    //PLOG_VERBOSE << "Parsing manifest for AppID: " << app->id;
-
-    std::string app_name =
-      SK_Steam_KeyValues::getValue (
-        app->steam.manifest_data, { "AppState" }, "name"
-      );
-
-    if (! app_name.empty ())
-    {
-      return app_name;
-    }
-  }
+  if (auto manifest = SK_GetManifestForAppID (app))
+    return manifest->getValue ({ "AppState", "name" });
 
   return "";
 }
@@ -568,24 +761,31 @@ SK_UseManifestToGetAppName (app_record_s *app)
 std::string
 SK_UseManifestToGetCurrentBranch (app_record_s *app)
 {
-  if (app->steam.manifest_data.empty())
-      app->steam.manifest_data =
-        SK_GetManifestContentsForAppID (app);
+  if (auto manifest = SK_GetManifestForAppID (app))
+    return manifest->getValue ({ "AppState", "UserConfig", "BetaKey" });
+
+  return "";
+}
+
+// Reads a user config store in one go; the KeyValues inside are streamed through
+//   SK_Steam_KeyValueQuery rather than built into a tree, as only a handful of paths are needed
+static std::string
+SKIF_Steam_ReadUserConfigStore (SteamId3_t userid, ConfigStore config)
+{
+  std::string   data;
+  std::ifstream file (SKIF_Steam_GetUserConfigStorePath (userid, config), std::ios::binary);
 
-  if (! app->steam.manifest_data.empty ())
+  if (file.is_open ())
   {
-    std::string branch =
-      SK_Steam_KeyValues::getValue (
-        app->steam.manifest_data, { "AppState", "UserConfig" }, "BetaKey"
-      );
+    file.seekg (0, std::ios::end);
+    data.resize (static_cast <size_t> (std::max <std::streamoff> (file.tellg (), 0)));
+    file.seekg (0, std::ios::beg);
+    file.read  (data.data (), data.size ());
 
-    if (! branch.empty ())
-    {
-      return branch;
-    }
+    data.resize (static_cast <size_t> (file.gcount ()));
   }
 
-  return "";
+  return data;
 }
 
 std::string
@@ -595,66 +795,38 @@ SKIF_Steam_GetLaunchOptions (AppId_t appid, SteamId3_t userid , app_record_s *ap
   app->steam.local.launch_option.clear();
   app->steam.local.launch_option_parsed.clear();
 
-  // Implementation using the ValveFileVDF project
-  std::ifstream file (SKIF_Steam_GetUserConfigStorePath (userid, ConfigStore_UserLocal));
+  // LaunchOptions is tracked at "UserLocalConfigStore" -> "Software" -> "valve" -> "Steam" -> "apps" -> "<app-id>" -> "LaunchOptions"
+  static const SK_Steam_KeyValueQuery
+    launch_options ({ "*/Software/Valve/Steam/Apps/*/LaunchOptions" });
 
-  if (file.is_open())
+  for (auto& match : launch_options.run (SKIF_Steam_ReadUserConfigStore (userid, ConfigStore_UserLocal)))
   {
-    try
-    {
-      auto user_localconfig = tyti::vdf::read(file);
-      file.close();
+    if (strtoul (match.captures [1].c_str (), nullptr, 10) != appid)
+      continue;
 
-      if (user_localconfig.childs.size() > 0)
-      {
-        // LaunchOptions is tracked at "UserLocalConfigStore" -> "Software" -> "valve" -> "Steam" -> "apps" -> "<app-id>" -> "LaunchOptions"
-        
-        std::shared_ptr <tyti::vdf::object>
-                                         apps_localconfig = SKIF_VDF_ciSearch ("Software", &user_localconfig.childs);
-        if (apps_localconfig != nullptr) apps_localconfig = SKIF_VDF_ciSearch ("Valve",    &apps_localconfig->childs);
-        if (apps_localconfig != nullptr) apps_localconfig = SKIF_VDF_ciSearch ("Steam",    &apps_localconfig->childs);
-        if (apps_localconfig != nullptr) apps_localconfig = SKIF_VDF_ciSearch ("Apps",     &apps_localconfig->childs);
-
-        /* case sensitive -- cannot be used
-        auto& apps_localconfig =
-          user_localconfig.
-            childs.at("Software") ->
-              childs.at("valve")  ->
-                childs.at("Steam")->
-                  childs.at("apps");
-        */
-
-        if (apps_localconfig != nullptr &&
-            apps_localconfig->childs.size() > 0)
-        {
-          auto lc_app = apps_localconfig->childs.find(std::to_string(appid));
-          if (lc_app != apps_localconfig->childs.end())
-          {
-            auto& attribs = lc_app->second->attribs;
+    // Also updates the copy
+    if (app != nullptr)
+      app->steam.local.launch_option = match.value;
 
-            if (! attribs.empty() && attribs.count("LaunchOptions") > 0)
-            {
-              // Also updates the copy
-              if (app != nullptr)
-                app->steam.local.launch_option = attribs.at("LaunchOptions");
+    return match.value;
+  }
 
-              return attribs.at("LaunchOptions");
-            }
-          }
-        }
-      }
-    }
+  return "";
+}
 
-    // I don't expect this to throw any std::out_of_range exceptions any more
-    //   but one can never be too sure when it comes to data structures like these.
-    //     - Aemony
-    catch (const std::exception& e)
-    {
-      UNREFERENCED_PARAMETER(e);
-    }
+// Steam apps of the library by appid, for matching query results against
+static std::unordered_map <AppId_t, app_record_s*>
+SKIF_Steam_MapApps (std::vector <std::pair < std::string, app_record_s > > *apps)
+{
+  std::unordered_map <AppId_t, app_record_s*> steam_apps;
+
+  for (auto& app : *apps)
+  {
+    if (app.second.store == app_record_s::Store::Steam)
+      steam_apps.emplace (app.second.id, &app.second);
   }
 
-  return "";
+  return steam_apps;
 }
 
 bool
@@ -682,100 +854,44 @@ SKIF_Steam_PreloadUserLocalConfig (SteamId3_t userid, std::vector <std::pair < s
 
   PLOG_INFO << "Preloading Steam user local config...";
 
-  // Implementation using the ValveFileVDF project
-  std::ifstream file (SKIF_Steam_GetUserConfigStorePath (userid, ConfigStore_UserLocal));
-
-  if (file.is_open())
-  {
-    try
-    {
-      auto user_localconfig = tyti::vdf::read(file);
-      file.close();
+  std::string data =
+    SKIF_Steam_ReadUserConfigStore (userid, ConfigStore_UserLocal);
 
-      if (user_localconfig.childs.size() > 0)
-      {
-        // Preload LaunchOptions...
-        // LaunchOptions are tracked at "UserLocalConfigStore" -> "Software" -> "valve" -> "Steam" -> "apps" -> "<app-id>" -> "LaunchOptions"
-        
-        std::shared_ptr <tyti::vdf::object>
-                                         apps_localconfig = SKIF_VDF_ciSearch ("Software", &user_localconfig.childs);
-        if (apps_localconfig != nullptr) apps_localconfig = SKIF_VDF_ciSearch ("Valve",    &apps_localconfig->childs);
-        if (apps_localconfig != nullptr) apps_localconfig = SKIF_VDF_ciSearch ("Steam",    &apps_localconfig->childs);
-        if (apps_localconfig != nullptr) apps_localconfig = SKIF_VDF_ciSearch ("Apps",     &apps_localconfig->childs);
-      //if (apps_localconfig != nullptr) PLOG_VERBOSE << "Found a match!";
-
-        /* case sensitive -- cannot be used
-        auto& apps_localconfig =
-          user_localconfig.
-            childs.at("Software") ->
-              childs.at("valve")  ->
-                childs.at("Steam")->
-                  childs.at("apps");
-        */
-
-        if (apps_localconfig != nullptr &&
-            apps_localconfig->childs.size() > 0)
-        {
-          for (auto& app : *apps)
-          {
-            if (app.second.store != app_record_s::Store::Steam)
-              continue;
+  if (data.empty ())
+    return false;
 
-            auto lc_app = apps_localconfig->childs.find(std::to_string(app.second.id));
-            if (lc_app != apps_localconfig->childs.end())
-            {
-              auto& attribs = lc_app->second->attribs;
+  // LaunchOptions are tracked at "UserLocalConfigStore" -> "Software" -> "valve" -> "Steam" -> "apps" -> "<app-id>" -> "LaunchOptions"
+  // AppTickets are tracked at "UserLocalConfigStore" -> "apptickets" -> "<app-id>"
+  //   and are used to determine if a DLC related launch option should be visible
+  enum { LaunchOptions, AppTickets };
 
-              if (! attribs.empty() && attribs.count("LaunchOptions") > 0)
-                app.second.steam.local.launch_option = attribs.at("LaunchOptions");
-            }
-          }
-        }
+  static const SK_Steam_KeyValueQuery
+    localconfig ({ "*/Software/Valve/Steam/Apps/*/LaunchOptions",
+                   "*/apptickets/*" });
 
-        // Preload DLC ownership...
-        // 
-        // AppTickets are tracked at "UserLocalConfigStore" -> "apptickets" -> "<app-id>"
-        // This is used to determine if a DLC related launch option should be visible
-        std::shared_ptr <tyti::vdf::object>
-          apptickets_localconfig =
-            SKIF_VDF_ciSearch ("apptickets", &user_localconfig.childs);
-            //user_localconfig.childs.at("apptickets"); // case sensitive -- cannot be used
-
-        if (apptickets_localconfig != nullptr &&
-            apptickets_localconfig->attribs.size() > 0)
-        {
-          // Naively assume an app ticket indicates ownership
-          for (auto& child : apptickets_localconfig->attribs)
-          {
-            if (! child.first.empty())
-            {
-              try {
-                apptickets->emplace (child.first);
-              } 
-              catch (const std::exception& e)
-              {
-                UNREFERENCED_PARAMETER(e);
-              }
-            }
-          }
-        }
+  auto steam_apps =
+    SKIF_Steam_MapApps (apps);
 
-        return true;
-      }
-    }
+  for (auto& match : localconfig.run (data))
+  {
+    const std::string& key =
+      match.captures [1];
 
-    // I don't expect this to throw any std::out_of_range exceptions any more
-    //   but one can never be too sure when it comes to data structures like these.
-    //     - Aemony
-    catch (const std::exception& e)
+    if (match.pattern == LaunchOptions)
     {
-      UNREFERENCED_PARAMETER(e);
+      auto app =
+        steam_apps.find (static_cast <AppId_t> (strtoul (key.c_str (), nullptr, 10)));
 
-      PLOG_ERROR << "Unknown error occurred when trying to parse localconfig.vdf";
+      if (app != steam_apps.end ())
+        app->second->steam.local.launch_option = std::move (match.value);
     }
+
+    // Naively assume an app ticket indicates ownership
+    else if (match.pattern == AppTickets && ! key.empty ())
+      apptickets->emplace (key);
   }
 
-  return false;
+  return true;
 }
 
 bool
@@ -800,82 +916,39 @@ SKIF_Steam_PreloadUserSharedConfig (SteamId3_t userid, std::vector <std::pair <
 
   PLOG_INFO << "Preloading Steam user roaming config...";
 
-  // Implementation using the ValveFileVDF project
-  std::ifstream file (SKIF_Steam_GetUserConfigStorePath (userid, ConfigStore_UserRoaming));
+  std::string data =
+    SKIF_Steam_ReadUserConfigStore (userid, ConfigStore_UserRoaming);
 
-  if (file.is_open())
-  {
-    try
-    {
-      auto vdfConfig = tyti::vdf::read(file);
-      file.close();
+  if (data.empty ())
+    return false;
 
-      if (vdfConfig.childs.size() > 0)
-      {
-        std::shared_ptr <tyti::vdf::object>
-                                          vdfConfigAppsTree  = SKIF_VDF_ciSearch ("Software", &vdfConfig.childs);
-        if (vdfConfigAppsTree != nullptr) vdfConfigAppsTree  = SKIF_VDF_ciSearch ("Valve",    &vdfConfigAppsTree->childs);
-        if (vdfConfigAppsTree != nullptr) vdfConfigAppsTree  = SKIF_VDF_ciSearch ("Steam",    &vdfConfigAppsTree->childs);
-        if (vdfConfigAppsTree != nullptr) vdfConfigAppsTree  = SKIF_VDF_ciSearch ("Apps",     &vdfConfigAppsTree->childs);
-      //if (vdfConfigAppsTree != nullptr) PLOG_VERBOSE << "Found a match!";
-
-        /* case sensitive -- cannot be used
-        auto& vdfConfigAppsTree =
-          vdfConfig. // UserRoamingConfigStore
-            childs.at("Software") ->
-              childs.at("Valve")  ->
-                childs.at("Steam")->
-                  childs.at("apps");
-        */
-
-        if (vdfConfigAppsTree != nullptr &&
-            vdfConfigAppsTree->childs.size() > 0)
-        {
-          for (auto& app : *apps)
-          {
-            if (app.second.store != app_record_s::Store::Steam)
-              continue;
+  // Hidden state is tracked at "UserRoamingConfigStore" -> "Software" -> "valve" -> "Steam" -> "apps" -> "<app-id>" -> "hidden" == 1
+  // Favorite state at          "UserRoamingConfigStore" -> "Software" -> "valve" -> "Steam" -> "apps" -> "<app-id>" -> "tags" -> "<order>" == "favorite"
+  enum { Hidden, Tags };
 
-            auto conf_app  = vdfConfigAppsTree->childs.find(std::to_string(app.second.id));
-            if ( conf_app != vdfConfigAppsTree->childs.end())
-            {
-              // Load hidden state...
-              // "UserRoamingConfigStore" -> "Software" -> "valve" -> "Steam" -> "apps" -> "<app-id>" -> "hidden" == 1
-              auto& attribs = conf_app->second->attribs;
-              if (! attribs.empty() && attribs.count("hidden") > 0 && attribs.at("hidden") == "1")
-                app.second.steam.shared.hidden     = 1;
-
-              // Load favorite state...
-              // "UserRoamingConfigStore" -> "Software" -> "valve" -> "Steam" -> "apps" -> "<app-id>" -> "tags" -> "<order>" == "favorite"
-              if (! conf_app->second->childs.empty() && conf_app->second->childs.count("tags") > 0)
-              {
-                auto& tags = conf_app->second->childs.at("tags");
-                for (auto& child : tags->attribs)
-                {
-                  if (! child.first.empty() && child.second == "favorite")
-                    app.second.steam.shared.favorite = 1;
-                }
-              }
-            }
-          }
-        }
+  static const SK_Steam_KeyValueQuery
+    sharedconfig ({ "*/Software/Valve/Steam/Apps/*/hidden",
+                    "*/Software/Valve/Steam/Apps/*/tags/*" });
 
-        return true;
-      }
-    }
+  auto steam_apps =
+    SKIF_Steam_MapApps (apps);
 
-    // I don't expect this to throw any std::out_of_range exceptions any more
-    //   but one can never be too sure when it comes to data structures like these.
-    //     - Aemony
-    catch (const std::exception& e)
-    {
-      UNREFERENCED_PARAMETER(e);
+  for (auto& match : sharedconfig.run (data))
+  {
+    auto app =
+      steam_apps.find (static_cast <AppId_t> (strtoul (match.captures [1].c_str (), nullptr, 10)));
 
-      PLOG_ERROR << "Unknown error occurred when trying to parse sharedconfig.vdf";
-    }
+    if (app == steam_apps.end ())
+      continue;
+
+    if      (match.pattern == Hidden && match.value == "1")
+      app->second->steam.shared.hidden   = 1;
+
+    else if (match.pattern == Tags   && match.value == "favorite")
+      app->second->steam.shared.favorite = 1;
   }
 
-  return false;
+  return true;
 }
 
 void
@@ -888,59 +961,23 @@ SKIF_Steam_PreloadUserConfig (SteamId3_t userid, std::vector<std::pair<std::stri
 bool
 SKIF_Steam_isSteamOverlayEnabled (AppId_t appid, SteamId3_t userid)
 {
-  std::ifstream file (SKIF_Steam_GetUserConfigStorePath (userid, ConfigStore_UserLocal));
-
-  if (file.is_open())
-  {
-    try
-    {
-      auto user_localconfig = tyti::vdf::read(file);
-      file.close();
+  // There are two relevant here:
+  // - Global state is tracked at "UserLocalConfigStore" -> "system" -> "EnableGameOverlay"
+  // - Game-specific state is tracked at "UserLocalConfigStore" -> "apps" -> "<app-id>" -> "OverlayAppEnable"
+  enum { Global, Game };
 
-      if (user_localconfig.childs.size() > 0)
-      {
-        // There are two relevant here:
-        // - Global state is tracked at "UserLocalConfigStore" -> "system" -> "EnableGameOverlay"
-        // - Game-specific state is tracked at "UserLocalConfigStore" -> "apps" -> "<app-id>" -> "OverlayAppEnable"
-
-        std::shared_ptr <tyti::vdf::object>
-          system_localconfig =
-            SKIF_VDF_ciSearch ("system", &user_localconfig.childs);
-          //user_localconfig.childs.at("system"); // case sensitive -- cannot be used
-          
-
-        // If global state is disabled, don't bother checking the local state
-        if (! system_localconfig->attribs.empty() && system_localconfig->attribs.count("EnableGameOverlay") > 0 && system_localconfig->attribs.at("EnableGameOverlay") == "0")
-          return false;
-
-        // Continue checking the local state
-        std::shared_ptr <tyti::vdf::object>
-          apps_localconfig =
-            SKIF_VDF_ciSearch ("apps", &user_localconfig.childs);
-          //user_localconfig.childs.at("apps"); // case sensitive -- cannot be used
-
-        if (apps_localconfig != nullptr &&
-            apps_localconfig->childs.size() > 0)
-        {
-          auto lc_app = apps_localconfig->childs.find(std::to_string(appid));
-          if (lc_app != apps_localconfig->childs.end())
-          {
-            auto& attribs = lc_app->second->attribs;
+  static const SK_Steam_KeyValueQuery
+    overlay ({ "*/system/EnableGameOverlay",
+               "*/apps/*/OverlayAppEnable" });
 
-            if (! attribs.empty() && attribs.count("OverlayAppEnable") > 0 && attribs.at("OverlayAppEnable") == "0")
-              return false;
-          }
-        }
-      }
-    }
+  for (auto& match : overlay.run (SKIF_Steam_ReadUserConfigStore (userid, ConfigStore_UserLocal)))
+  {
+    if (match.value != "0")
+      continue;
 
-    // I don't expect this to throw any std::out_of_range exceptions any more
-    //   but one can never be too sure when it comes to data structures like these.
-    //     - Aemony
-    catch (const std::exception& e)
-    {
-      UNREFERENCED_PARAMETER(e);
-    }
+    if (match.pattern == Global ||
+        strtoul (match.captures [1].c_str (), nullptr, 10) == appid)
+      return false;
   }
 
   return true;
@@ -951,23 +988,8 @@ SK_UseManifestToGetAppOwner (app_record_s *app)
 {
   //PLOG_VERBOSE << "Steam AppID: " << appid;
 
-  std::string manifest_data =
-    SK_GetManifestContentsForAppID (app);
-
-  if (! manifest_data.empty ())
-  {
-    //PLOG_VERBOSE << "Parsing manifest for AppID: " << appid;
-
-    std::string app_owner =
-      SK_Steam_KeyValues::getValue (
-        manifest_data, { "AppState" }, "LastOwner"
-      );
-
-    if (! app_owner.empty ())
-    {
-      return app_owner;
-    }
-  }
+  if (auto manifest = SK_GetManifestForAppID (app))
+    return manifest->getValue ({ "AppState", "LastOwner" });
 
   return "";
 }
@@ -980,17 +1002,11 @@ SK_UseManifestToGetInstallDir (app_record_s *app)
   if (! app->install_dir.empty())
     return app->install_dir;
 
-  if (app->steam.manifest_data.empty())
-    app->steam.manifest_data =
-      SK_GetManifestContentsForAppID (app);
-
-  if (! app->steam.manifest_data.empty ())
+  if (auto manifest = SK_GetManifestForAppID (app))
   {
-    //PLOG_VERBOSE << "Parsing manifest for AppID: " << appid;
-
     std::wstring app_path =
-      SK_Steam_KeyValues::getValueAsUTF16 (
-        app->steam.manifest_data, { "AppState" }, "installdir"
+      SK_UTF8ToWideChar (
+        manifest->getValue ({ "AppState", "installdir" })
       );
 
     if (! app_path.empty ())
@@ -1019,28 +1035,22 @@ SK_UseManifestToGetDepots (app_record_s *app)
 {
   std::vector <SK_Steam_Depot> depots;
 
-  std::string manifest_data =
-    SK_GetManifestContentsForAppID (app);
-
-  if (! manifest_data.empty ())
+  if (auto manifest = SK_GetManifestForAppID (app))
   {
-    std::vector <std::string> values;
-    auto                      mounted_depots =
-      SK_Steam_KeyValues::getKeys (
-        manifest_data, { "AppState", "MountedDepots" }, &values
-      );
-
-    int idx = 0;
+    manifest->forEach ( manifest->find ({ "AppState", "MountedDepots" }),
+      [&](const SK_Steam_KeyValueTree::node_s& depot)
+      {
+        if (depot.section)
+          return;
 
-    for ( auto& it : mounted_depots )
-    {
-      depots.push_back (
-        SK_Steam_Depot {
-          "", static_cast <uint32_t> (atoi  (it            .c_str ())),
-              static_cast <uint64_t> (atoll (values [idx++].c_str ()))
-        }
-      );
-    }
+        depots.push_back (
+          SK_Steam_Depot {
+            "", static_cast <uint32_t> (atoi  (depot.key  .c_str ())),
+                static_cast <uint64_t> (atoll (depot.value.c_str ()))
+          }
+        );
+      }
+    );
   }
 
   return depots;
@@ -1049,20 +1059,15 @@ SK_UseManifestToGetDepots (app_record_s *app)
 ManifestId_t
 SK_UseManifestToGetDepotManifest (app_record_s *app, DepotId_t depot)
 {
-  std::string manifest_data =
-    SK_GetManifestContentsForAppID (app);
-
-  if (! manifest_data.empty ())
+  if (auto manifest = SK_GetManifestForAppID (app))
   {
-    return
-      atoll (
-        SK_Steam_KeyValues::getValue (
-          manifest_data, {
-            "AppState", "InstalledDepots", std::to_string (depot)
-          },
-          "manifest"
-        ).c_str ()
-      );
+    const uint32_t installed =
+      manifest->find (manifest->find ({ "AppState", "InstalledDepots" }), depot);
+    const uint32_t manifest_id =
+      manifest->find (installed, "manifest");
+
+    if (manifest_id != SK_Steam_KeyValueTree::npos)
+      return atoll (manifest->nodes [manifest_id].value.c_str ());
   }
 
   return 0;
@@ -1090,14 +1095,17 @@ SKIF_Steam_areLibrariesSignaled (void)
   if (! g_SteamLibrariesParsed.load())
     return false;
 
-  if (! TryEnterCriticalSection (&VFSManifestSection))
-    return false;
-
   for (int i = 0; i < steam_libs; i++)
   {
     auto& library =
       steam_libraries[i];
 
+    // Libraries that are being scanned right now are checked again on the next call
+    std::unique_lock <std::mutex> lock (library.mutex, std::try_to_lock);
+
+    if (! lock.owns_lock ())
+      continue;
+
     // SKIF_FrameCount iterates at the start of the frame, so even the first frame will be frame count 1
     if (library.frame_last_scanned == 0)
     {
@@ -1106,15 +1114,13 @@ SKIF_Steam_areLibrariesSignaled (void)
                 (wchar_t *)steam_lib_paths [i] );
 
       library.timer = static_cast <UINT_PTR>(1983 + i); // 1983-1999
+      library.frame_last_scanned = SKIF_FrameCount.load();
     }
 
-    bool countFiles = (library.frame_last_scanned == 0);
-
-    // If we detect any changes, delay checking the details for a couple of seconds 
-    if (library.watch.isSignaled (library.path)) // UITab_Library // We do not wake up when unfocused as that causes SKIF to constantly be active during downloads/updates
+    // If we detect any changes, delay checking the details for a couple of seconds
+    //   We do not wake up when unfocused as that causes SKIF to constantly be active during downloads/updates
+    if (SK_Steam_UpdateLibraryManifests (library))
     {
-      library.signaled = SKIF_Util_timeGetTime ( );
-
       // Create a timer to trigger a refresh after the time has expired
       SetTimer (SKIF_Notify_hWnd, library.timer, 2500 + 50, NULL);
     }
@@ -1124,32 +1130,122 @@ SKIF_Steam_areLibrariesSignaled (void)
     {
       KillTimer (SKIF_Notify_hWnd, library.timer);
       library.signaled = 0;
-      countFiles = true;
     }
 
-    if (countFiles)
+    // Rescans (first scan, or lost events) are not debounced
+    if (library.changed && library.signaled == 0)
     {
-      library.frame_last_scanned = SKIF_FrameCount.load();
+      library.changed = false;
+      isSignaled      = true;
+    }
+  }
+
+  return isSignaled;
+};
 
-      int prevCount = library.count;
-      
-      // Clear out any existing paths
-      library.manifest_vfs.clear();
 
-      library.count =
-        SK_VFS_ScanTree ( library.manifest_vfs,
-                          library.path, L"appmanifest_*.acf", 0);
+// Signals (debounced) once Steam has stopped writing to appinfo.vdf for a couple of seconds
+bool
+SKIF_Steam_isAppInfoSignaled (void)
+{
+  static SKIF_CommonPathsCache& _path_cache = SKIF_CommonPathsCache::GetInstance ( );
 
-      if (library.count != prevCount)
-        isSignaled = true;
+  extern HWND      SKIF_Notify_hWnd;
+
+  if (SKIF_Notify_hWnd == NULL || _path_cache.steam_install[0] == L'\0')
+    return false;
+
+  static SKIF_DirectoryWatch watch;
+  static DWORD               signaled      = 0;
+  static FILETIME            ftLastWrite   = { };
+  static std::wstring        appcache_path =
+    SK_FormatStringW (LR"(%ws\appcache)",              _path_cache.steam_install);
+  static std::wstring        appinfo_path  =
+    SK_FormatStringW (LR"(%ws\appcache\appinfo.vdf)", _path_cache.steam_install);
+
+  auto _GetLastWriteTime = [&](void) -> FILETIME
+  {
+    WIN32_FILE_ATTRIBUTE_DATA fileAttributeData = { };
+
+    if (GetFileAttributesExW (appinfo_path.c_str (), GetFileExInfoStandard, &fileAttributeData))
+      return fileAttributeData.ftLastWriteTime;
+
+    return { };
+  };
+
+  // The first call only sets up the watch and a baseline
+  SK_RunOnce (ftLastWrite = _GetLastWriteTime ( ));
+
+  // Steam writes a bunch of other files in here as well
+  if (watch.isSignaled (appcache_path))
+  {
+    signaled = SKIF_Util_timeGetTime ( );
+
+    // Create a timer to trigger a refresh after the time has expired
+    SetTimer (SKIF_Notify_hWnd, IDT_REFRESH_APPINFO, 2500 + 50, NULL);
+  }
+
+  // Only refresh if there has been no further changes to the folder recently
+  if (0 < signaled && signaled + 2500 < SKIF_Util_timeGetTime ( ))
+  {
+    KillTimer (SKIF_Notify_hWnd, IDT_REFRESH_APPINFO);
+    signaled = 0;
+
+    FILETIME ftCurrent =
+      _GetLastWriteTime ( );
+
+    if (CompareFileTime (&ftCurrent, &ftLastWrite) != 0)
+    {
+      ftLastWrite = ftCurrent;
+
+      return true;
     }
   }
 
-  LeaveCriticalSection (&VFSManifestSection);
+  return false;
+}
 
-  return isSignaled;
+struct SK_Steam_LibraryScan
+{
+  int            index;
+  int            frame_count;
+  const wchar_t* source; // Library root, as returned by SK_Steam_GetLibraries
 };
 
+// Brings the manifest set of a single library up to date and publishes it
+static void
+SK_Steam_ScanLibrary (SK_Steam_LibraryScan* scan)
+{
+  auto& library =
+    steam_libraries [scan->index];
+
+  std::lock_guard <std::mutex> lock (library.mutex);
+
+  // SKIF_FrameCount iterates at the start of the frame, so even the first frame will be frame count 1
+  if (library.frame_last_scanned == 0)
+  {
+    swprintf (library.path, MAX_PATH + 2,
+                  LR"(%s\steamapps)",
+                        scan->source );
+
+    library.timer = static_cast <UINT_PTR>(1983 + scan->index); // 1983-1999
+  }
+
+  // Change events are applied by SKIF_Steam_areLibrariesSignaled on the UI thread, so this only
+  //   rescans the folder if it is not being watched (yet), if events were lost, or if some have
+  //     not been applied yet (once per frame at most)
+  if (library.frame_last_scanned != scan->frame_count)
+  {
+    if (library.manifests.rescan || ! library.watch.active ( ) || library.watch.queued ( ))
+    {
+      library.manifests.scan (SK_Steam_ListManifests (library.path));
+      library.publish ( );
+    }
+
+    library.frame_last_scanned = scan->frame_count;
+    library.changed            = false;
+  }
+}
 
 // This is an internal helper function used by SKIF_Steam_GetInstalledAppIDs ( ).
 // This function discovers and returns an unprocessed vector of all apps on the system.
@@ -1170,67 +1266,62 @@ SKIF_SteamInt_DiscoverInstalledApps (void)
 
   if (steam_libs != 0)
   {
-    EnterCriticalSection (&VFSManifestSection);
+    const DWORD dwStart =
+      SKIF_Util_timeGetTime1 ( );
+
+    std::vector <SK_Steam_LibraryScan> scans (steam_libs);
+    std::vector <HANDLE>               workers;
 
-    // Scan through the libraries first for all appmanifest files they contain
+    // Libraries usually sit on separate drives, so each one is brought up to date
+    //   on its own thread rather than having the seeks of one wait on the other
     for (int i = 0; i < steam_libs; i++)
     {
-      auto& library =
-        steam_libraries[i];
+      scans [i] = { i, frame_count_, (wchar_t *)steam_lib_paths [i] };
 
-      // SKIF_FrameCount iterates at the start of the frame, so even the first frame will be frame count 1
-      if (library.frame_last_scanned == 0)
+      HANDLE hWorkerThread = (steam_libs == 1) ? NULL : (HANDLE)
+      _beginthreadex (nullptr, 0x0, [](void* var) -> unsigned
       {
-        swprintf (library.path, MAX_PATH + 2,
-                      LR"(%s\steamapps)",
-                  (wchar_t *)steam_lib_paths [i] );
+        SKIF_Util_SetThreadDescription (GetCurrentThread (), L"SKIF_LibraryScan");
 
-        library.timer = static_cast <UINT_PTR>(1983 + i); // 1983-1999
-      }
+        SK_Steam_ScanLibrary (static_cast <SK_Steam_LibraryScan*> (var));
 
-      // Scan the folder if we haven't already done so during this frame
-      if (library.frame_last_scanned != frame_count_)
-      {
-        library.frame_last_scanned    = frame_count_;
+        return 0;
+      }, &scans [i], 0x0, nullptr);
 
-        // Clear out any existing paths
-        library.manifest_vfs.clear();
+      if (hWorkerThread != NULL)
+        workers.push_back (hWorkerThread);
+      else
+        SK_Steam_ScanLibrary (&scans [i]);
+    }
 
-        library.count =
-          SK_VFS_ScanTree ( library.manifest_vfs,
-                            library.path, L"appmanifest_*.acf", 0);
-      }
-      
-      SK_VirtualFS::vfsNode* pFolder =
-        library.manifest_vfs;
+    if (! workers.empty ())
+      WaitForMultipleObjects (static_cast <DWORD> (workers.size ()), workers.data (), TRUE, INFINITE);
 
-      // Really, this will just iterate once, across pFolder->children[0]
-      //   ...as long as SKIF doesn't dynamically recognize
-      //        new Steam libraries during runtime, that is...
-      for (const auto& folder : pFolder->children)
-      {
-        // Now add the App IDs of all manifests that are installed,
-        //   and also check for Special K ownership on Steam...
-        for (const auto& file : folder.second->children)
-        {
-          uint32_t appid;
+    for (auto hWorker : workers)
+      CloseHandle (hWorker);
 
-          if ( swscanf (file.first.c_str(),
-                            L"appmanifest_%lu.acf",
-                              &appid ) == 1 )
-          {
-            apps.push_back (appid);
+    // Now add the App IDs of all manifests that are installed,
+    //   and also check for Special K ownership on Steam...
+    for (int i = 0; i < steam_libs; i++)
+    {
+      auto manifests =
+        steam_libraries[i].published.load ();
 
-            if (appid == 1157970)
-              bHasSpecialK = true;
-          }
-        }
+      if (manifests == nullptr)
+        continue;
+
+      for (auto appid : manifests->appids)
+      {
+        apps.push_back (appid);
+
+        if (appid == 1157970)
+          bHasSpecialK = true;
       }
     }
 
     g_SteamLibrariesParsed.store (true);
 
-    LeaveCriticalSection (&VFSManifestSection);
+    PLOG_VERBOSE << "Scanned " << steam_libs << " Steam libraries in " << (SKIF_Util_timeGetTime1 ( ) - dwStart) << " ms";
   }
   
   if (bHasSpecialK)
@@ -1299,6 +1390,109 @@ SKIF_SteamInt_DiscoverInstalledApps (void)
 }
 
 
+using SK_Steam_ManifestQueue =
+  std::vector <std::pair <app_record_s*, std::wstring>>;
+
+static void
+SK_Steam_ReadManifestQueue (SK_Steam_ManifestQueue* queue)
+{
+  for (auto& manifest : *queue)
+  {
+    auto app = manifest.first;
+
+    // Every app has its manifest parsed for its name shortly after, so do so here as well
+    if (SK_Steam_ReadManifest (manifest.second.c_str (), app))
+      app->steam.manifest_kv =
+        std::make_shared <SK_Steam_KeyValueTree> (app->steam.manifest_data);
+  }
+}
+
+// Reads the appmanifest files of all given Steam apps up front. There is one
+//   queue per volume, so libraries spread across several disks are read
+//     concurrently while reads within a disk stay sequential.
+static void
+SK_Steam_PrefetchManifests (std::vector <std::pair < std::string, app_record_s > > *apps)
+{
+  const DWORD dwStart =
+    SKIF_Util_timeGetTime1 ( );
+
+  auto steam_apps =
+    SKIF_Steam_MapApps (apps);
+
+  std::map <std::wstring, SK_Steam_ManifestQueue> volumes;
+
+  size_t queued = 0;
+
+  for (auto& library : steam_libraries)
+  {
+    auto manifests =
+      library.published.load ();
+
+    if (manifests == nullptr)
+      continue;
+
+    wchar_t wszVolume [MAX_PATH + 2] = { };
+
+    if (! GetVolumePathNameW (manifests->path.c_str (), wszVolume, MAX_PATH))
+      wcsncpy_s (wszVolume, MAX_PATH, manifests->path.c_str (), _TRUNCATE);
+
+    auto& queue =
+      volumes [wszVolume];
+
+    for (auto appid : manifests->appids)
+    {
+      auto app =
+        steam_apps.find (appid);
+
+      if (app == steam_apps.end () || ! app->second->steam.manifest_data.empty ())
+        continue;
+
+      wchar_t wszManifestFullPath [MAX_PATH + 2] = { };
+      swprintf ( wszManifestFullPath, MAX_PATH,
+                   LR"(%s\appmanifest_%u.acf)",
+                     manifests->path.c_str (), appid );
+
+      queue.emplace_back (app->second, wszManifestFullPath);
+      queued++;
+
+      // The first library an app is found in wins, same as SK_GetManifestContentsForAppID
+      steam_apps.erase (app);
+    }
+  }
+
+  std::vector <HANDLE> workers;
+
+  for (auto& volume : volumes)
+  {
+    if (volume.second.empty ())
+      continue;
+
+    HANDLE hWorkerThread = (HANDLE)
+    _beginthreadex (nullptr, 0x0, [](void* var) -> unsigned
+    {
+      SKIF_Util_SetThreadDescription (GetCurrentThread (), L"SKIF_ManifestPrefetch");
+
+      SK_Steam_ReadManifestQueue (static_cast <SK_Steam_ManifestQueue*> (var));
+
+      return 0;
+    }, &volume.second, 0x0, nullptr);
+
+    if (hWorkerThread != NULL)
+      workers.push_back (hWorkerThread);
+    else
+      SK_Steam_ReadManifestQueue (&volume.second);
+  }
+
+  if (! workers.empty ())
+    WaitForMultipleObjects (static_cast <DWORD> (workers.size ()), workers.data (), TRUE, INFINITE);
+
+  for (auto hWorker : workers)
+    CloseHandle (hWorker);
+
+  PLOG_VERBOSE << "Prefetched " << queued << " appmanifest files from " << volumes.size ()
+               << " volume(s) in " << (SKIF_Util_timeGetTime1 ( ) - dwStart) << " ms";
+}
+
 // Updates the given vector with a filtered list of all discovered Steam apps.
 // Filters out various non-game type of apps.
 void
@@ -1316,7 +1510,7 @@ SKIF_Steam_GetInstalledAppIDs (std::vector <std::pair < std::string, app_record_
     if (app == 228980) continue;
 
     // Skip IDs related to apps, DLCs, music, and tools (including Special K for now)
-    if (std::find(std::begin(steam_apps_ignorable), std::end(steam_apps_ignorable), app) != std::end(steam_apps_ignorable)) continue;
+    if (SKIF_Steam_isIgnorableApp (app)) continue;
 
     if (unique_apps.emplace (app).second)
     {
@@ -1327,10 +1521,12 @@ SKIF_Steam_GetInstalledAppIDs (std::vector <std::pair < std::string, app_record_
       // Opening the manifests to read the names is a
       //   lengthy operation, so defer names and icons
       apps->emplace_back (
-        "Loading...", record
+        "Loading...", std::move (record)
       );
     }
   }
+
+  SK_Steam_PrefetchManifests (apps);
 };
 
 
@@ -20,11 +20,19 @@
 // DEALINGS IN THE SOFTWARE.
 //
 
+#include <SKIF.h>
 #include <stores/Steam/vdf.h>
+#include <stores/Steam/vdf_internal.h>
 #include <utility/fsutil.h>
+#include <utility/binary_cache.h>
 #include <regex>
 #include <stores/Steam/steam_library.h>
 #include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <process.h>
 
 const int SKIF_STEAM_APPID = 1157970;
 
@@ -32,1243 +40,1499 @@ const int SKIF_STEAM_APPID = 1157970;
 using appinfo_s     = skValveDataFile::appinfo_s;
 using app_section_s =                  appinfo_s::section_s;
 
-uint32_t skValveDataFile::vdf_version = 0x27; // Default to Pre-December 2022
+// Totals for the selective parser, logged and reset whenever a batch is published
+static std::atomic <uint64_t> SKIF_VDF_BytesParsed  = 0;
+static std::atomic <uint64_t> SKIF_VDF_BytesSkipped = 0;
 
-skValveDataFile::skValveDataFile (std::wstring source) : path (source)
+// Bump whenever the layout of appinfo_data_s or the serialization below changes
+static constexpr uint32_t SKIF_APPINFO_CACHE_MAGIC   = 0x43414B53; // SKAC
+static constexpr uint32_t SKIF_APPINFO_CACHE_VERSION = 1;
+
+bool
+skValveDataFile::processApps (std::span <app_record_s*> apps)
 {
-  FILE *fData = nullptr;
+  if (_batch != nullptr || apps.empty ())
+    return false;
+
+  // The batch keeps the file open until it is published or cancelled
+  if (! acquireFile ( ))
+    return false;
 
-  _wfopen_s (&fData, path.c_str (), L"rbS");
+  _batch = std::make_unique <batch_s> ( );
+  _batch->reader  = this;
+  _batch->started = SKIF_Util_timeGetTime1 ( );
+  _batch->results.reserve (apps.size ());
 
-  if (fData != nullptr)
+  // Walk the apps in file order, which lets a windowed reader slide forward
+  //   instead of jumping back and forth across the file
+  std::vector <std::pair <uint64_t, app_record_s*>> ordered;
+  ordered.reserve (apps.size ());
+
+  for (auto* pApp : apps)
   {
-#ifdef _WIN64
-    _fseeki64 (fData, 0, SEEK_END);
-#else
-    fseek     (fData, 0, SEEK_END);
-#endif
-    size_t
-    size =
-#ifdef _WIN64
-    _ftelli64 (fData);
-#else
-    ftell     (fData);
-#endif
-    rewind    (fData);
+    if (pApp != nullptr)
+    {
+      auto pEntry =
+        findApp (pApp->id);
 
-    _data.resize (size);
+      ordered.emplace_back (pEntry != nullptr ? pEntry->offset : _size, pApp);
+    }
+  }
 
-    fread  (_data.data (), size, 1, fData);
-    fclose (                        fData);
+  std::stable_sort ( ordered.begin (), ordered.end (),
+    [](const auto& lhs, const auto& rhs)
+    {
+      return lhs.first < rhs.first;
+    }
+  );
 
-    base =
-      reinterpret_cast <
-             header_s *> (_data.data ());
+  for (auto& app : ordered)
+    _batch->results.emplace_back (app.second->clone ( ));
 
-    vdf_version =
-      ((uint8_t *)&base->version)[0];
+  const size_t num_workers =
+    std::clamp <size_t> (std::thread::hardware_concurrency ( ), 1, 8);
 
-    root =
-      &base->head;
+  PLOG_DEBUG << "[AppInfo Processing] Processing " << _batch->results.size () << " apps using "
+                                                   << std::min (num_workers, _batch->results.size ()) << " workers...";
 
-    // A string table was added in June of 2024 (0x29)
-    if (vdf_version >= 0x29)
+  for (size_t i = 0; i < std::min (num_workers, _batch->results.size ()); i++)
+  {
+    HANDLE hWorkerThread = (HANDLE)
+    _beginthreadex (nullptr, 0x0, [](void* var) -> unsigned
     {
-      uintptr_t strtable_pos
-            =   (uintptr_t)*(uint64_t *)root;
-      root  = (appinfo_s *)((uint64_t *)root + 1);
-      table = (str_tbl_s *)(&_data [strtable_pos]);
-
-      // Valve is using 64-bit offsets, if this file is larger than
-      //   4 GiB SKIF32 is fundamentally inoperable!
-      PLOG_ERROR_IF (
-        *(uint64_t *)root > std::numeric_limits <uintptr_t>::max ()
-      ) << "VDF File is Too Large!";
+      SKIF_Util_SetThreadDescription (GetCurrentThread (), L"SKIF_AppInfoWorker");
 
-      strs.reserve   (        table->num_strings);
-      strs.push_back ((char *)table->strings);
+      batch_s* pBatch = static_cast <batch_s*> (var);
 
-      char* str     = (char *)table->strings;
-      char* end_tbl = (char *)_data.data () +
-                              _data.size ();
+      for ( size_t idx  = pBatch->next++ ;
+                   idx  < pBatch->results.size () && ! pBatch->cancelled.load () ;
+                   idx  = pBatch->next++ )
+      {
+        pBatch->reader->getAppInfo (&pBatch->results [idx]);
+      }
 
-      for (DWORD i = 1; i < table->num_strings; ++i)
+      // The last worker out wakes up the UI thread so the results get published
+      if (--pBatch->active == 0 && ! pBatch->cancelled.load ())
       {
-        while (*str++ != '\0' && str < end_tbl);
+        extern HWND SKIF_Notify_hWnd;
+        PostMessage (SKIF_Notify_hWnd, WM_SKIF_APPINFO, 0x0, 0x0);
+      }
 
-        if (str > end_tbl)
-        {
-          // On overflow, restart table iteration from the beginning
-          PLOG_ERROR << "Malformed string table detected!";
-          str = (char *)table->strings;
-        }
+      return 0;
+    }, _batch.get (), CREATE_SUSPENDED, nullptr);
 
-        strs.push_back (str);
-      }
-    }
+    if (hWorkerThread != NULL)
+      _batch->workers.push_back (hWorkerThread);
+  }
+
+  _batch->active.store (_batch->workers.size ());
+
+  for (auto hWorker : _batch->workers)
+    ResumeThread (hWorker);
+
+  // Someting went wrong during thread creation, so do it the slow way
+  if (_batch->workers.empty ())
+  {
+    PLOG_ERROR << "[AppInfo Processing] Failed to create any worker threads!";
+
+    for (auto& app : _batch->results)
+      getAppInfo (&app);
   }
+
+  return true;
+}
+
+bool
+skValveDataFile::isProcessing (void)
+{
+  if (_batch == nullptr)
+    return false;
+
+  for (auto hWorker : _batch->workers)
+  {
+    if (WaitForSingleObject (hWorker, 0) != WAIT_OBJECT_0)
+      return true;
+  }
+
+  return false;
 }
 
 void
-app_section_s::parse (section_desc_s& desc)
+skValveDataFile::cancelProcessing (void)
+{
+  _cancelBatch ( );
+}
+
+bool
+skValveDataFile::publishApps (std::vector <std::pair < std::string, app_record_s > > *apps)
 {
-  static
-    std::map <_TokenOp,size_t>
-                    operand_sizes =
-    { { Int32, sizeof (int32_t) },
-      { Int64, sizeof (int64_t) } };
+  if (_batch == nullptr || isProcessing ( ))
+    return false;
+
+  for (auto hWorker : _batch->workers)
+    CloseHandle (hWorker);
+
+  const DWORD dwElapsed =
+    SKIF_Util_timeGetTime1 ( ) - _batch->started;
+
+  const uint64_t parsed  = SKIF_VDF_BytesParsed .exchange (0);
+  const uint64_t skipped = SKIF_VDF_BytesSkipped.exchange (0);
+
+  PLOG_DEBUG << "[AppInfo Processing] Processed " << _batch->results.size () << " apps in " << dwElapsed << " ms ("
+             << ((double)dwElapsed / std::max <size_t> (_batch->results.size (), 1)) << " ms/app), tokenised "
+             << (parsed - skipped) << " of " << parsed << " bytes (" << skipped << " skipped)";
 
-  std::vector <
-    section_data_s
-  > raw_sections;
+  std::unordered_map <AppId_t, app_record_s*> results;
 
-  static bool exception = false;
+  for (auto& result : _batch->results)
+    results.emplace (result.id, &result);
 
-  if (! exception)
+  bool changed = false;
+
+  for (auto& app : *apps)
   {
-    for ( uint8_t *cur = (uint8_t *)desc.blob             ;
-                   cur < (uint8_t *)desc.blob + desc.size ;
-                   cur++ )
+    auto& record = app.second;
+
+    if (record.store != app_record_s::Store::Steam || record.processed)
+      continue;
+
+    auto it = results.find (record.id);
+
+    if (it == results.end ())
+      continue;
+
+    app_record_s* pResult = it->second;
+
+    // Also flag apps lacking appinfo data as processed so they are not retried every frame
+    if (pResult->processed)
     {
-      auto op =
-        (_TokenOp)(*cur);
+      record.install_dir           = std::move (pResult->install_dir);
+      record.steam.manifest_data   = std::move (pResult->steam.manifest_data);
+      record.steam.manifest_kv     = std::move (pResult->steam.manifest_kv);
+      record.steam.manifest_path   = std::move (pResult->steam.manifest_path);
+      record.common_config         = std::move (pResult->common_config);
+      record.extended_config       = std::move (pResult->extended_config);
+      record.launch_configs        = std::move (pResult->launch_configs);
+      record.cloud_saves           = std::move (pResult->cloud_saves);
+      record.cloud_enabled         =            pResult->cloud_enabled;
+      record.branches              = std::move (pResult->branches);
+
+      for (auto& branch : record.branches)
+        branch.second.parent = &record;
+    }
 
-      auto name =
-        (char *)(cur + 1);
+    record.processed = true;
+    changed          = true;
+  }
 
-      if (op != SectionEnd)
-      {
-        // String Table Lookup (June 2024+)
-        //
-        if (appinfo->vdf_version >= 0x29)
-        {
-          name =
-            (char *)appinfo->table->strings;
+  _batch.reset ();
+   releaseFile ( );
 
-          const auto str_idx =
-            *(uint32_t *)(cur + 1);
+  // Persist whatever the batch had to parse from scratch
+  _cacheSave ();
 
-#ifdef DEBUG
-          PLOG_VERBOSE << "String Table Index:  " << str_idx << ", op=" << op;
-#endif
+  return changed;
+}
 
-          if ( str_idx < appinfo->table->num_strings )
-          {
-            name =
-              appinfo->strs [str_idx];
-#ifdef DEBUG
-            PLOG_VERBOSE << "String=" << name;
-#endif
-          }
+void
+skValveDataFile::_cancelBatch (void)
+{
+  if (_batch == nullptr)
+    return;
 
-          else
-            PLOG_ERROR << "String Table Index (" << str_idx << ") Out-of-Range!";
+  _batch->cancelled.store (true);
 
-          cur += 4;
-        }
+  for (auto hWorker : _batch->workers)
+  {
+    WaitForSingleObject (hWorker, INFINITE);
+    CloseHandle         (hWorker);
+  }
 
-        // Legacy: null-terminated name is serialized inline after token type
-        //
-        else
-        {
-          // Skip past name declarations, except for </Section> because it has no name.
-                  cur++;
-          while (*cur != '\0')
-                ++cur;
-        }
-      }
+  _batch.reset ();
+   releaseFile ( );
+}
 
-      if (op == SectionBegin)
-      {
-        if (! raw_sections.empty ())
-              raw_sections.push_back ({ raw_sections.back ().name + std::string (".") +
-                                        name, {  (void *)cur, 0 } });
-        else
-          raw_sections.push_back     ({ name, {  (void *)cur, 0 } });
-      }
+static void
+SKIF_AppInfoCache_Write (SKIF_BinaryWriter& out, const appinfo_data_s& data)
+{
+  out.pod <uint8_t>  (data.has_common);
+  out.pod <uint32_t> ((uint32_t)data.common.cpu_type);
+  out.pod <uint32_t> ((uint32_t)data.common.type);
+  out.str            (data.common.icon_hash);
+  out.str            (data.common.boxart_hash);
+  out.str            (data.vac_module);
+  out.pod <int32_t>  (data.hide_cloud_ui);
 
-      else if (op == SectionEnd)
-      {
-        if (! raw_sections.empty ())
-        {     raw_sections.back  ().desc.size =
-            (uintptr_t)cur -
-            (uintptr_t)raw_sections.back      ().desc.blob;
-                  finished_sections.push_back (raw_sections.back ());
-                        raw_sections.pop_back  ();
-        }
-      }
+  out.pod <uint32_t> ((uint32_t)data.launch_configs.size ());
 
-      else
-      {
-        ++cur;
+  for (auto& launch : data.launch_configs)
+  {
+    out.pod <int32_t>  (launch.first);
+    out.pod <int32_t>  (launch.second.id);
+    out.pod <int32_t>  (launch.second.id_steam);
+    out.pod <uint32_t> ((uint32_t)launch.second.type);
+    out.pod <uint32_t> ((uint32_t)launch.second.cpu_type);
+    out.pod <uint32_t> ((uint32_t)launch.second.platforms);
+    out.str            (launch.second.executable);
+    out.str            (launch.second.launch_options);
+    out.str            (launch.second.description);
+    out.str            (launch.second.working_dir);
+    out.str            (launch.second.requires_dlc);
+
+    out.pod <uint32_t> ((uint32_t)launch.second.branches.size ());
+
+    for (auto& branch : launch.second.branches)
+      out.str (branch);
+  }
 
-        switch (op)
-        {
-          case String:
-            if (! raw_sections.empty ())
-            {     raw_sections.back ().keys.push_back (
-                { name, { String, (void *)cur }}
-              );
-            } else { exception = true; }
-            while (*cur != '\0')     ++cur;
-            break;
+  out.pod <uint32_t> ((uint32_t)data.branches.size ());
 
-          case Int32:
-          case Int64:
-            if (! raw_sections.empty ())
-            {     raw_sections.back ().keys.push_back (
-                { name, { op, (void *)cur }}
-              );
-            } else { exception = true; }
-            cur += (operand_sizes [op]-1);
-            break;
+  for (auto& branch : data.branches)
+  {
+    out.str            (branch.first);
+    out.pod <uint32_t> (branch.second.build_id);
+    out.pod <uint32_t> (branch.second.pwd_required);
+    out.pod <int64_t>  (branch.second.time_updated);
+    out.str            (branch.second.description);
+  }
 
-          default:
-            PLOG_WARNING << "Unknown VDF Token Operator: " << op;
-            exception = true;
-            break;
-        }
-      }
-    }
+  out.pod <uint32_t> ((uint32_t)data.root_overrides.size ());
+
+  for (auto& root_override : data.root_overrides)
+  {
+    out.str (root_override.root);
+    out.str (root_override.use_instead);
+    out.str (root_override.add_path);
+  }
+
+  out.pod <uint32_t> ((uint32_t)data.save_files.size ());
+
+  for (auto& save_file : data.save_files)
+  {
+    out.pod <int32_t>  (save_file.first);
+    out.pod <uint8_t>  (save_file.second.has_root);
+    out.pod <uint8_t>  (save_file.second.has_path);
+    out.pod <uint32_t> ((uint32_t)save_file.second.platforms);
+    out.str            (save_file.second.root);
+    out.str            (save_file.second.path);
   }
 }
 
-void*
-appinfo_s::getRootSection (size_t* pSize)
+static bool
+SKIF_AppInfoCache_Read (SKIF_BinaryReader& in, appinfo_data_s& data)
 {
-  size_t vdf_header_size =
-    ( vdf_version > 0x27 ? sizeof (appinfo_s)
-                         : sizeof (appinfo27_s) );
-
-  static bool
-      runOnce = true;
-  if (runOnce)
-  {   runOnce = false;
-  
-    switch (vdf_version)
-    {
-      case 0x29: // v41
-        PLOG_VERBOSE << "appinfo.vdf version: " << vdf_version << " (June 2024)";
-        break;
-      case 0x28: // v40
-        PLOG_VERBOSE << "appinfo.vdf version: " << vdf_version << " (December 2022)";
-        break;
-      case 0x27: // v39
-        PLOG_VERBOSE << "appinfo.vdf version: " << vdf_version << " (pre-December 2022)";
-        break;
-      default:
-        PLOG_WARNING << "appinfo.vdf version: " << vdf_version << " (unknown/unsupported)";
-    }
+  data.has_common         =                                                  in.pod <uint8_t>  ( ) != 0;
+  data.common.cpu_type    = static_cast <app_record_s::CPUType>                (in.pod <uint32_t> ( ));
+  data.common.type        = static_cast <app_record_s::common_config_s::AppType>(in.pod <uint32_t> ( ));
+  data.common.icon_hash   = in.str ( );
+  data.common.boxart_hash = in.str ( );
+  data.vac_module         = in.str ( );
+  data.hide_cloud_ui      = in.pod <int32_t> ( );
+
+  for (uint32_t i = 0, count = in.pod <uint32_t> ( ); i < count && in.ok; i++)
+  {
+    auto& launch =
+      data.launch_configs [in.pod <int32_t> ( )];
+
+    launch.id             = in.pod <int32_t> ( );
+    launch.id_steam       = in.pod <int32_t> ( );
+    launch.type           = static_cast <app_record_s::launch_config_s::Type> (in.pod <uint32_t> ( ));
+    launch.cpu_type       = static_cast <app_record_s::CPUType>               (in.pod <uint32_t> ( ));
+    launch.platforms      = static_cast <app_record_s::Platform>              (in.pod <uint32_t> ( ));
+    launch.executable     = in.wstr ( );
+    launch.launch_options = in.wstr ( );
+    launch.description    = in.wstr ( );
+    launch.working_dir    = in.wstr ( );
+    launch.requires_dlc   = in.str  ( );
+
+    for (uint32_t j = 0, branches = in.pod <uint32_t> ( ); j < branches && in.ok; j++)
+      launch.branches.emplace (in.str ( ));
   }
 
-  size_t kv_size =
-    (size - vdf_header_size + 8);
+  for (uint32_t i = 0, count = in.pod <uint32_t> ( ); i < count && in.ok; i++)
+  {
+    auto& branch =
+      data.branches [in.str ( )];
+
+    branch              = { };
+    branch.build_id     = in.pod <uint32_t> ( );
+    branch.pwd_required = in.pod <uint32_t> ( );
+    branch.time_updated = static_cast <time_t> (in.pod <int64_t> ( ));
+    branch.description  = in.wstr ( );
+  }
+
+  for (uint32_t i = 0, count = in.pod <uint32_t> ( ); i < count && in.ok; i++)
+  {
+    appinfo_data_s::root_override_s
+                   root_override;
+
+    root_override.root        = in.str  ( );
+    root_override.use_instead = in.str  ( );
+    root_override.add_path    = in.wstr ( );
 
-  if (pSize != nullptr)
-     *pSize  = kv_size;
+    data.root_overrides.push_back (root_override);
+  }
+
+  for (uint32_t i = 0, count = in.pod <uint32_t> ( ); i < count && in.ok; i++)
+  {
+    auto& save_file =
+      data.save_files [in.pod <int32_t> ( )];
+
+    save_file.has_root  = in.pod <uint8_t> ( ) != 0;
+    save_file.has_path  = in.pod <uint8_t> ( ) != 0;
+    save_file.platforms = static_cast <app_record_s::Platform> (in.pod <uint32_t> ( ));
+    save_file.root      = in.str  ( );
+    save_file.path      = in.wstr ( );
+  }
 
-  return
-    (uint8_t*)&appid + vdf_header_size;
+  return in.ok;
 }
 
-appinfo_s*
-appinfo_s::getNextApp (void)
+void
+skValveDataFile::_cacheLoad (void)
 {
-  section_desc_s root_sec{};
+  static SKIF_CommonPathsCache& _path_cache = SKIF_CommonPathsCache::GetInstance ( );
+
+  _cache = std::make_unique <cache_s> ( );
+  _cache->path =
+    SK_FormatStringW (LR"(%ws\Assets\Steam\appinfo.cache)", _path_cache.specialk_userdata);
+
+  std::vector <BYTE> buffer;
 
-  root_sec.blob =
-    getRootSection (&root_sec.size);
+  if (! SKIF_BinaryReader::load (_cache->path, buffer))
+    return;
 
-  auto *pNext =
-    (appinfo_s *)(
-      (uint8_t *)root_sec.blob +
-                 root_sec.size);
+  SKIF_BinaryReader in { buffer.data (), buffer.data () + buffer.size () };
 
-  return
-    ( pNext->appid == _LastSteamApp ) ?
-                              nullptr : pNext;
+  if (in.pod <uint32_t> ( ) != SKIF_APPINFO_CACHE_MAGIC ||
+      in.pod <uint32_t> ( ) != SKIF_APPINFO_CACHE_VERSION)
+  {
+    PLOG_INFO << "Discarding outdated or unrecognized appinfo cache";
+    return;
+  }
+
+  for (uint32_t i = 0, count = in.pod <uint32_t> ( ); i < count && in.ok; i++)
+  {
+    cache_s::entry_s entry;
+
+    AppId_t appid    = in.pod <uint32_t> ( );
+    entry.change_num = in.pod <uint32_t> ( );
+    in.raw (entry.sha1sum, sizeof (entry.sha1sum));
+
+    if (! SKIF_AppInfoCache_Read (in, entry.data))
+      break;
+
+    _cache->entries.emplace (appid, std::move (entry));
+  }
+
+  if (! in.ok)
+  {
+    PLOG_WARNING << "The appinfo cache is truncated or corrupt, it will be rebuilt!";
+
+    _cache->entries.clear ();
+    _cache->dirty = true;
+  }
+
+  PLOG_VERBOSE << "Loaded " << _cache->entries.size () << " apps from the appinfo cache";
 }
 
-appinfo_s*
-skValveDataFile::getAppInfo ( uint32_t appid, std::vector <std::pair < std::string, app_record_s > > *apps )
+void
+skValveDataFile::_cacheSave (void)
 {
-  static SKIF_CommonPathsCache& _path_cache = SKIF_CommonPathsCache::GetInstance ( );
+  if (_cache == nullptr)
+    return;
+
+  std::lock_guard <std::mutex> lock (_cache->mutex);
+
+  if (! _cache->dirty)
+    return;
+
+  SKIF_BinaryWriter out;
+
+  out.pod <uint32_t> (SKIF_APPINFO_CACHE_MAGIC);
+  out.pod <uint32_t> (SKIF_APPINFO_CACHE_VERSION);
 
+  size_t count_pos = out.buf.size ();
+  out.pod <uint32_t> (0);
+
+  uint32_t count = 0;
+
+  for (auto& entry : _cache->entries)
+  {
+    // Drop apps that Steam no longer knows about, or that have since changed
+    auto pEntry =
+      findApp (entry.first);
+
+    if (pEntry == nullptr || pEntry->change_num != entry.second.change_num)
+      continue;
+
+    out.pod <uint32_t> (entry.first);
+    out.pod <uint32_t> (entry.second.change_num);
+    out.raw            (entry.second.sha1sum, sizeof (entry.second.sha1sum));
+
+    SKIF_AppInfoCache_Write (out, entry.second.data);
+
+    count++;
+  }
+
+  memcpy (out.buf.data () + count_pos, &count, sizeof (count));
+
+  if (out.save (_cache->path))
+  {
+    PLOG_VERBOSE << "Saved " << count << " apps to the appinfo cache";
+    _cache->dirty = false;
+  }
+}
+
+bool
+skValveDataFile::_cacheLookup (appinfo_s* pIter, appinfo_data_s& data)
+{
+  if (_cache == nullptr)
+    return false;
+
+  std::lock_guard <std::mutex> lock (_cache->mutex);
+
+  auto it =
+    _cache->entries.find (pIter->appid);
+
+  if (it == _cache->entries.end ()                     ||
+      it->second.change_num != pIter->change_num       ||
+      memcmp (it->second.sha1sum, pIter->sha1sum, sizeof (pIter->sha1sum)) != 0)
+    return false;
+
+  data = it->second.data;
+
+  return true;
+}
+
+void
+skValveDataFile::_cacheStore (appinfo_s* pIter, const appinfo_data_s& data)
+{
+  if (_cache == nullptr)
+    return;
+
+  std::lock_guard <std::mutex> lock (_cache->mutex);
+
+  auto& entry =
+    _cache->entries [pIter->appid];
+
+  entry.change_num = pIter->change_num;
+  entry.data       = data;
+  memcpy (entry.sha1sum, pIter->sha1sum, sizeof (entry.sha1sum));
+
+  _cache->dirty = true;
+}
+
+std::vector <AppId_t>
+skValveDataFile::supersede (skValveDataFile& previous)
+{
+  std::vector <AppId_t> changed;
+
+  // The previous reader is about to go away, anything it had in flight is stale
+  previous._cancelBatch ( );
+
+  // Both indexes are sorted by appid, so a single merge pass is enough
+  auto prev =
+    previous.index.cbegin ( );
+
+  for (auto& entry : index)
+  {
+    while (prev != previous.index.cend () && prev->appid < entry.appid)
+         ++prev;
+
+    if (prev == previous.index.cend () || prev->appid      != entry.appid
+                                       || prev->change_num != entry.change_num)
+    {
+      changed.push_back (entry.appid);
+      continue;
+    }
+
+    if (prev->sha1 != entry.sha1)
+      changed.push_back (entry.appid);
+  }
+
+  // Carry over anything the previous reader extracted but never wrote to disk
+  if (_cache != nullptr && previous._cache != nullptr)
+  {
+    {
+      std::scoped_lock <std::mutex, std::mutex> lock (_cache->mutex, previous._cache->mutex);
+
+      for (auto& entry : previous._cache->entries)
+      {
+        if (_cache->entries.emplace (entry.first, std::move (entry.second)).second)
+          _cache->dirty = true;
+      }
+    }
+
+    // Otherwise it would overwrite the cache file with its own, older, view on destruction
+    previous._cache.reset ();
+  }
+
+  PLOG_INFO << "appinfo.vdf was updated, " << changed.size () << " apps were added or changed";
+
+  return changed;
+}
+
+void
+skValveDataFile::resetApp (app_record_s* pAppRecord)
+{
+  if (pAppRecord == nullptr || ! pAppRecord->processed)
+    return;
+
+  // Everything _applyAppInfo ( ) populated; launch_configs_custom is left
+  //   alone as it gets merged back into launch_configs when reprocessed
+  pAppRecord->common_config   = { };
+  pAppRecord->extended_config = { };
+  pAppRecord->launch_configs.clear ();
+  pAppRecord->cloud_saves   .clear ();
+  pAppRecord->branches      .clear ();
+  pAppRecord->cloud_enabled = true;
+  pAppRecord->processed     = false;
+}
+
+bool
+skValveDataFile::getAppInfo (app_record_s* pAppRecord)
+{
   extern bool SKIF_STEAM_OWNER;
 
+  if (pAppRecord == nullptr)
+    return false;
+
+  const uint32_t appid =
+    pAppRecord->id;
+
   // Skip call if it concerns someone whom does not have SKIF installed on Steam
   if ( appid == SKIF_STEAM_APPID &&
              (! SKIF_STEAM_OWNER) )
-    return nullptr;
+    return false;
+
+  // Skip already processed apps
+  if (pAppRecord->processed)
+    return false;
+
+  auto pEntry =
+    findApp (appid);
+
+  if (pEntry == nullptr)
+    return false;
 
-  if (root != nullptr)
+  // Opens the file for just this app, unless a batch already has it open
+  if (! acquireFile ( ))
+    return false;
+
+  appinfo_s* pIter =
+    reinterpret_cast <appinfo_s *> (
+      _acquireView (pEntry->offset, sizeof (appinfo27_s::appid) +
+                                    sizeof (appinfo27_s::size)  + pEntry->size)
+    );
+
+  if (pIter == nullptr)
   {
-    skValveDataFile::appinfo_s *pIter = root;
+    releaseFile ( );
+    return false;
+  }
 
-    while (pIter != nullptr && pIter->appid != _LastSteamApp)
-    {
-      if (pIter->appid == appid)
-      {
-        app_record_s* pAppRecord = nullptr;
+  appinfo_data_s data;
 
-        for (auto& app : *apps)
-        {
-          if (app.second.id == appid && app.second.store == app_record_s::Store::Steam)
-          {
-            pAppRecord = &app.second;
-            break;
-          }
-        }
+  // Only parse the KeyValues blob if the app changed since it was last cached
+  if (! _cacheLookup (pIter, data))
+  {
+    if (_extractAppInfo (pIter, data))
+      _cacheStore (pIter, data);
+  }
 
-        // If we're dealing with an unrecognized app, process it into a dummy object
-        if (! pAppRecord)
-        {
-          static app_record_s _non_steam (appid);
-          pAppRecord = &_non_steam;
-        }
+  _releaseView ((BYTE *)pIter);
+   releaseFile ( );
 
-        // Skip already processed apps
-        else if (pAppRecord->processed)
-          break;
+  _applyAppInfo (pAppRecord, data);
+
+  pAppRecord->processed = true;
 
-        static DWORD dwSingleThread  = GetCurrentThreadId ();
-        assert      (dwSingleThread == GetCurrentThreadId ());
+  return true;
+}
+
+bool
+skValveDataFile::_extractAppInfo (appinfo_s* pIter, appinfo_data_s& data)
+{
+  using _PathId = appinfo_s::section_s::_PathId;
+  using _KeyId  = appinfo_s::section_s::_KeyId;
 
-        static appinfo_s::section_s      section;
-        appinfo_s::section_desc_s app_desc{};
+  // Reused by every app parsed on this thread, so the tape only allocates while warming up
+  static thread_local appinfo_s::section_s                        section;
+  static thread_local std::vector <appinfo_s::section_s::key_s>  keys;
 
-        section.finished_sections.clear ();
+  appinfo_s::section_desc_s app_desc{};
 
-        app_desc.blob =
-          pIter->getRootSection (&app_desc.size);
+  app_desc.blob =
+    pIter->getRootSection (&app_desc.size);
 
-        section.parse (app_desc);
 //#define _WRITE_APPID_INI
 #ifdef  _WRITE_APPID_INI
-        FILE* fTest =
-          fopen (SK_FormatString ("appid%d.ini", pAppRecord->id).c_str (), "w");
+  section.selective = false;
 #endif
 
-        bool populate_appinfo_extended =
-          pAppRecord->extended_config.vac.enabled == -1;
-        bool populate_common =
-          pAppRecord->common_config.appid == 0;
-        bool populate_cloud_saves =
-         //pAppRecord != nullptr &&
-          pAppRecord->cloud_saves.empty ();
-
-        bool populate_branches  =
-        //pAppRecord != nullptr &&
-          pAppRecord->branches.empty ();
+  section.parse (app_desc, *this);
 
-        bool populate_launch_configs =
-        //pAppRecord != nullptr      &&
-          pAppRecord->launch_configs.empty ();
+  SKIF_VDF_BytesParsed  += app_desc.size;
+  SKIF_VDF_BytesSkipped += section.bytes_skipped;
 
-        bool get_library_asset_paths = true;
+#ifdef  _WRITE_APPID_INI
+  FILE* fTest =
+    fopen (SK_FormatString ("appid%d.ini", pIter->appid).c_str (), "w");
+#endif
 
-        pAppRecord->install_dir =
-          SK_UseManifestToGetInstallDir (pAppRecord);
+  auto _ParseOSArch =
+  [&](const appinfo_s::section_s::key_s& kv) ->
+  app_record_s::CPUType
+  {
+    app_record_s::CPUType cpu_type = app_record_s::CPUType::Common;
+    int                   bits = -1;
 
-        for (auto& finished_section : section.finished_sections)
-        {
-          if (finished_section.keys.empty ())
-            continue;
+    // This key is an integer sometimes and a string others, it's a PITA!
+    if (kv.op == appinfo_s::section_s::String)
+    {
+      bits =
+        *(char *)kv.value;
 
-          if (pAppRecord != nullptr)
-          {
-            if ( populate_appinfo_extended &&
-                 0 == finished_section.name.find ("appinfo.extended") )
-            {
-              auto *pVac =
-                &pAppRecord->extended_config.vac;
-
-              //auto *pDev =
-              //  &pAppRecord->extended_config.dev;
-
-              for (auto& key : finished_section.keys)
-              {
-                if (! _stricmp (key.first, "vacmodulefilename"))
-                {
-                  pVac->vacmodulefilename =
-                    (const char *)key.second.second;
-                }
-
-                if (! pVac->vacmodulefilename.empty ())
-                      pVac->enabled = true;
-                else
-                      pVac->enabled = false;
-              }
-
-              if (pVac->enabled == -1)
-                pVac->enabled = false;
-            }
-            
-            else if (pAppRecord->extended_config.vac.enabled == -1)
-              pAppRecord->extended_config.vac.enabled = false;
+      if (bits == 0)
+      {
+        cpu_type =
+         app_record_s::CPUType::Any;
+      }
 
-            auto _ParseOSArch =
-            [&](appinfo_s::section_s::_kv_pair& kv) ->
-            app_record_s::CPUType
-            {
-              app_record_s::CPUType cpu_type = app_record_s::CPUType::Common;
-              int                   bits = -1;
-
-              // This key is an integer sometimes and a string others, it's a PITA!
-              if (kv.second.first == appinfo_s::section_s::String)
-              {
-                bits =
-                  *(char *)kv.second.second;
-
-                if (bits == 0)
-                {
-                  cpu_type =
-                   app_record_s::CPUType::Any;
-                }
-
-                else
-                {
-                  bits =
-                    std::atoi ((char *)kv.second.second);
-                }
-              }
-
-              if (bits != 0)
-              {
-                // We have an int32 key, need to extract the value
-                if (bits == -1)
-                  bits = *(int32_t *)kv.second.second;
-
-                // else
-                // ... Otherwise we already got the value as a string
-
-                switch (bits)
-                {
-                  case 32:
-                    cpu_type =
-                      app_record_s::CPUType::x86;
-                    break;
-                  case 64:
-                    cpu_type =
-                      app_record_s::CPUType::x64;
-                    break;
-                  default:
-                    cpu_type =
-                      app_record_s::CPUType::Any;
-                    PLOG_ERROR << SK_FormatString ("Got unexpected (int32) CPU osarch=%lu", bits);
-                    break;
-                }
-              }
-
-              return cpu_type;
-            };
-
-            if ( populate_common &&
-                 0 ==
-                 finished_section.name.find ("appinfo.common") )
-            {
-              pAppRecord->common_config.appid = pAppRecord->id;
-
-              for (auto& key : finished_section.keys)
-              {
-                // OS Arch? More like CPU Arch...
-                // 
-                // This key, under common_config, either:
-                //  - do not exist at all, see  23310: The Last Remnant           (what does this mean?)
-                //  -            is empty, see    480: Spacewar (or most games)   (what does this mean? x86?)
-                //  -      is set to "64", see 546560: Half-Life: Alyx
-                //
-                // This makes it utterly useless for anything reliable, lol
-                // 
-                // See SteamDB's unique values search:
-                // - https://steamdb.info/search/?a=app_keynames&type=-1&keyname=369&operator=9&keyvalue=&display_value=on
-
-                if (! _stricmp (key.first, "osarch"))
-                {
-                  pAppRecord->common_config.cpu_type =
-                    _ParseOSArch (key);
-                }
-                
-                else if (! _stricmp (key.first, "type"))
-                {
-                  if      (! _stricmp ((char *)key.second.second, "game"))
-                    pAppRecord->common_config.type =
-                      app_record_s::common_config_s::AppType::Game;
-                  else if (! _stricmp ((char *)key.second.second, "application"))
-                    pAppRecord->common_config.type =
-                      app_record_s::common_config_s::AppType::Application;
-                  else if (! _stricmp ((char *)key.second.second, "tool"))
-                    pAppRecord->common_config.type =
-                      app_record_s::common_config_s::AppType::Tool;
-                  else if (! _stricmp ((char *)key.second.second, "music"))
-                    pAppRecord->common_config.type =
-                      app_record_s::common_config_s::AppType::Music;
-                  else if (! _stricmp ((char *)key.second.second, "demo"))
-                    pAppRecord->common_config.type =
-                      app_record_s::common_config_s::AppType::Demo;
-                }
-
-                else if (! _stricmp (key.first, "icon"))
-                {
-                  pAppRecord->common_config.icon_hash = (char *)key.second.second;
-                }
-              }
-            }
+      else
+      {
+        bits =
+          std::atoi ((char *)kv.value);
+      }
+    }
 
-            if ( get_library_asset_paths &&
-                 finished_section.name._Equal ("appinfo.common.library_assets_full.library_capsule.image") )
-            {
-              bool found_english_asset = false;
-              for (auto& key : finished_section.keys)
-              {
-                if (! _stricmp (key.first, "english"))
-                {
-                  pAppRecord->common_config.boxart_hash = (const char*)key.second.second;
-                  found_english_asset = true;
-                  break;
-                }
-              }
-
-              if (! found_english_asset)
-              {
-                // Since language is not known, just use the first language found
-                for (auto& key : finished_section.keys)
-                {
-                  pAppRecord->common_config.boxart_hash = (const char*)key.second.second;
-                  break;
-                }
-              }
-              get_library_asset_paths = false;
-            }
+    if (bits != 0)
+    {
+      // We have an int32 key, need to extract the value
+      if (bits == -1)
+        bits = *(int32_t *)kv.value;
 
-            if ( populate_launch_configs &&
-                 0 ==
-                 finished_section.name.find ("appinfo.config.launch.")
-               )
-            {
-              //PLOG_VERBOSE << "---------------------------";
-
-              int launch_idx_skif =
-                static_cast<int> (pAppRecord->launch_configs.size());
-              int launch_idx_steam = 0; // We do not currently actually use this for anything.
-                                        // It is also unreliable as developers can remove launch configs...
-
-              std::sscanf ( finished_section.name.c_str (),
-                              "appinfo.config.launch.%d", &launch_idx_steam);
-
-              // The index used solely for parsing
-              int idx = launch_idx_steam;
-
-              // Use the Steam launch key to workaround some parsing issue or another...
-              // TODO: Fix this shit -- it's a shitty workaround for stupid duplicate parsing!
-              //       AND it breaks Instant Play custom options... :(
-              auto& launch_cfg =
-                pAppRecord->launch_configs [launch_idx_steam]; 
-
-              launch_cfg.id       = launch_idx_skif;
-              launch_cfg.id_steam = launch_idx_steam;
-
-              // Holds Widechar strings (external)
-              std::unordered_map <std::string, std::wstring*>
-                wstring_map = {
-                  { "executable",  &launch_cfg.executable     },
-                  { "arguments",   &launch_cfg.launch_options },
-                  { "description", &launch_cfg.description    },
-                  { "workingdir",  &launch_cfg.working_dir    }
-                };
-
-              // Holds UTF8 strings (internal only)
-              std::unordered_map <std::string, std::string*>
-                 string_map = {
-              //  { "betakey",     &launch_cfg.beta_key       }, // TODO: Fix this shit -- it's landing on the duplicate launch configs
-                  { "ownsdlc",     &launch_cfg.requires_dlc   }
-                };
-
-              for (auto& key : finished_section.keys)
-              {
-                if (! _stricmp (key.first, "oslist"))
-                {
-                  if (StrStrIA ((const char *)key.second.second, "windows"))
-                  {
-                    app_record_s::addSupportFor (
-                      pAppRecord->launch_configs [idx].platforms,
-                                                app_record_s::Platform::Windows
-                      );
-                  }
-
-                  else
-                    pAppRecord->launch_configs [idx].platforms =
-                      app_record_s::Platform::Unknown;
-                }
-
-                else if (! _stricmp (key.first, "osarch"))
-                {
-                  // OS Arch? More like CPU Arch...
-                  pAppRecord->launch_configs [idx].cpu_type =
-                    _ParseOSArch (key);
-                }
-
-                else if (! _stricmp (key.first, "betakey"))
-                {
-                  // Populate required betas for this launch option
-                  std::istringstream betas((const char *)key.second.second);
-                  std::string beta;
-                  while (std::getline (betas, beta, ' '))
-                    pAppRecord->launch_configs [idx].branches.emplace (beta);
-                }
-
-                else if (! _stricmp (key.first, "type"))
-                {
-                  if (! _stricmp ((char *)key.second.second,      "default"))
-                    pAppRecord->launch_configs [idx].type =
-                      app_record_s::launch_config_s::Type::Default;
-
-                  else if (! _stricmp ((char *)key.second.second, "option1"))
-                    pAppRecord->launch_configs [idx].type =
-                      app_record_s::launch_config_s::Type::Option1;
-
-                  else if (! _stricmp ((char *)key.second.second, "option2"))
-                    pAppRecord->launch_configs [idx].type =
-                      app_record_s::launch_config_s::Type::Option2;
-
-                  else if (! _stricmp ((char *)key.second.second, "option3"))
-                    pAppRecord->launch_configs [idx].type =
-                      app_record_s::launch_config_s::Type::Option3;
-
-                  else if (! _stricmp ((char *)key.second.second, "none"))
-                    pAppRecord->launch_configs [idx].type =
-                      app_record_s::launch_config_s::Type::Unspecified;
-                }
-
-                else if (wstring_map.count (key.first) != 0)
-                {
-                  auto& string_dest =
-                    wstring_map [key.first];
-
-                  *string_dest =
-                    SK_UTF8ToWideChar ((const char *)key.second.second);
-                }
-
-                else if (string_map.count (key.first) != 0)
-                {
-                  auto& string_dest =
-                    string_map [key.first];
-
-                  *string_dest =
-                    std::string ((const char *)key.second.second);
-                }
-              }
-              
-              // There is a really annoying bug in SKIF where parsing the launch configs results in semi-duplicate empty entries,
-              //   though I have no idea why... Maybe has to do with some "padding" between the sections in the appinfo.vdf file?
+      // else
+      // ... Otherwise we already got the value as a string
 
-#if 0
+      switch (bits)
+      {
+        case 32:
+          cpu_type =
+            app_record_s::CPUType::x86;
+          break;
+        case 64:
+          cpu_type =
+            app_record_s::CPUType::x64;
+          break;
+        default:
+          cpu_type =
+            app_record_s::CPUType::Any;
+          PLOG_ERROR << SK_FormatString ("Got unexpected (int32) CPU osarch=%lu", bits);
+          break;
+      }
+    }
 
-              PLOG_VERBOSE << "Steam Launch ID   : " <<       launch_idx_steam;
-              PLOG_VERBOSE << "SKIF  Launch ID   : " <<       launch_idx_skif;
-              PLOG_VERBOSE << "Executable        : " <<       launch_cfg.executable;
-              PLOG_VERBOSE << "Arguments         : " <<       launch_cfg.launch_options;
-              PLOG_VERBOSE << "Working Directory : " <<       launch_cfg.working_dir;
-              PLOG_VERBOSE << "Launch Type       : " << (int) launch_cfg.type;
-              PLOG_VERBOSE << "Description       : " <<       launch_cfg.description;
-              PLOG_VERBOSE << "Operating System  : " << (int) launch_cfg.platforms;
-              PLOG_VERBOSE << "CPU Architecture  : " << (int) launch_cfg.cpu_type;
-              PLOG_VERBOSE << "Beta key          : " <<       launch_cfg.beta_key;
-              PLOG_VERBOSE << "Owns DLC          : " <<       launch_cfg.owns_dlc;
+    return cpu_type;
+  };
 
-#endif
+  const auto& tape =
+    section.tape;
 
-            }
-          }
-        }
+  // Sections are visited in the order they are closed, i.e. children before their parents
+  for (uint32_t end_row = 0; end_row < tape.size (); end_row++)
+  {
+    if (tape.op [end_row] != appinfo_s::section_s::SectionEnd)
+      continue;
 
-        // If the appinfo.vdf didn't contain library asset paths, default to standard path
-        if (get_library_asset_paths)
-        {
-          pAppRecord->common_config.boxart_hash = "library_600x900.jpg";
-        }
+    const uint32_t row  = tape.parent [end_row];
+    const _PathId  path = (_PathId)tape.path [row];
 
-        // At this point, since we used Steam's index as the position to stuff data into, the vector has
-        //   has objects all over -- some at 0, some at 1, others at 0-4, not 5, 6-9. Basically we cannot
-        //     be certain of anything, at all, what so bloody ever! So let's just recreate the std::map!
+#ifndef _WRITE_APPID_INI
+    if (path == _PathId::Ignored)
+      continue;
+#endif
 
-        std::vector <app_record_s::launch_config_s> _cleaner;
+    section.keysOf (row, keys);
 
-        // Put away put away put away put away
-        for ( auto& keep : pAppRecord->launch_configs )
-          _cleaner.push_back (keep.second);
-        
-        // Clean clean clean clean!
-        pAppRecord->launch_configs.clear ();
+    if (keys.empty ())
+      continue;
 
-        // Restore restore restore restore!
-        for ( auto& launch : _cleaner )
+    if ( path == _PathId::Extended )
+    {
+      for (auto& key : keys)
+      {
+        if (key.id == _KeyId::vacmodulefilename)
         {
-          // Reset SKIF's internal identifer for the launch configs
-          launch.id = 
-            static_cast<int> (pAppRecord->launch_configs.size());
-
-          // Add it back
-          pAppRecord->launch_configs.emplace (
-            static_cast<int> (pAppRecord->launch_configs.size()),
-            launch);
+          data.vac_module =
+            (const char *)key.value;
         }
-        // std::map is now reliable again!
+      }
+    }
 
-        std::set    <std::wstring>          _used_executables;
-        std::set    <std::wstring>          _used_executables_arguments;
-        std::vector <app_record_s::launch_config_s> _launches;
+    if ( path >= _PathId::Common &&
+         path <= _PathId::CommonLibraryCapsuleImage )
+    {
+      data.has_common = true;
 
-        // Now add in our custom launch configs!
-        for (auto& custom_cfg : pAppRecord->launch_configs_custom)
+      for (auto& key : keys)
+      {
+        switch (key.id)
         {
-          custom_cfg.second.id =
-            static_cast<int> (pAppRecord->launch_configs.size());
+          // OS Arch? More like CPU Arch...
+          // 
+          // This key, under common_config, either:
+          //  - do not exist at all, see  23310: The Last Remnant           (what does this mean?)
+          //  -            is empty, see    480: Spacewar (or most games)   (what does this mean? x86?)
+          //  -      is set to "64", see 546560: Half-Life: Alyx
+          //
+          // This makes it utterly useless for anything reliable, lol
+          // 
+          // See SteamDB's unique values search:
+          // - https://steamdb.info/search/?a=app_keynames&type=-1&keyname=369&operator=9&keyvalue=&display_value=on
+          case _KeyId::osarch:
+            data.common.cpu_type =
+              _ParseOSArch (key);
+            break;
 
-          // Custom launch config, so Steam launch ID is nothing we use
-          custom_cfg.second.id_steam = -1;
+          case _KeyId::type:
+            if      (! _stricmp ((char *)key.value, "game"))
+              data.common.type =
+                app_record_s::common_config_s::AppType::Game;
+            else if (! _stricmp ((char *)key.value, "application"))
+              data.common.type =
+                app_record_s::common_config_s::AppType::Application;
+            else if (! _stricmp ((char *)key.value, "tool"))
+              data.common.type =
+                app_record_s::common_config_s::AppType::Tool;
+            else if (! _stricmp ((char *)key.value, "music"))
+              data.common.type =
+                app_record_s::common_config_s::AppType::Music;
+            else if (! _stricmp ((char *)key.value, "demo"))
+              data.common.type =
+                app_record_s::common_config_s::AppType::Demo;
+            break;
 
-          if (! pAppRecord->launch_configs.emplace (custom_cfg.second.id, custom_cfg.second).second)
-            PLOG_ERROR << "Failed adding a custom launch config to the launch map. An element at that position already exists!";
-        }
+          case _KeyId::icon:
+            data.common.icon_hash = (char *)key.value;
+            break;
 
-        // Clear out the custom launches once they've been populated
-        pAppRecord->launch_configs_custom.clear();
+          default:
+            break;
+        }
+      }
+    }
 
-        for ( auto& launch_cfg : pAppRecord->launch_configs )
+    if ( data.common.boxart_hash.empty () &&
+         path == _PathId::CommonLibraryCapsuleImage )
+    {
+      for (auto& key : keys)
+      {
+        if (key.id == _KeyId::english)
         {
-          auto& launch = launch_cfg.second;
-
-          // Summarize the branches in a comma-delimited string as well
-          if (! launch.branches.empty())
-          {
-            for (auto const& branch : launch.branches)
-              launch.branches_joined += branch + ", ";
+          data.common.boxart_hash = (const char*)key.value;
+          break;
+        }
+      }
 
-            // Remove trailing comma and space
-            launch.branches_joined.pop_back();
-            launch.branches_joined.pop_back();
-          }
+      // Since language is not known, just use the first language found
+      if (data.common.boxart_hash.empty ())
+        data.common.boxart_hash = (const char*)keys.front ().value;
+    }
 
-          // Filter launch configurations for other OSes
-          if ( (! app_record_s::supports (launch.platforms,
-                                   app_record_s::Platform::Windows) ))
-            continue;
+    if ( path == _PathId::LaunchEntry )
+    {
+      int launch_idx_skif =
+        static_cast<int> (data.launch_configs.size());
+      int launch_idx_steam = 0; // We do not currently actually use this for anything.
+                                // It is also unreliable as developers can remove launch configs...
 
-          // Filter launch configurations lacking an executable
-          // This also skips all the semi-weird duplicate launch configs SKIF randomly creates
-          if (launch.executable.empty())
-            continue;
+      // Keys may be nested in a child (e.g. config) of appinfo.config.launch.<n>
+      const uint32_t entry_row =
+        section.entryOf (row, _PathId::ConfigLaunch);
 
-          // Filter launch configurations requiring a beta branch that the user do not have
-          if (! launch.branches.empty() && launch.branches.count (pAppRecord->steam.branch) == 0)
-            launch.valid = 0;
+      if (entry_row != appinfo_s::section_s::_NoParent)
+        std::sscanf (tape.name [entry_row], "%d", &launch_idx_steam);
 
-          // File extension, so we can flag out non-executable ones (e.g. link2ea)
-          const wchar_t* pwszExtension =
-            PathFindExtension (launch.executable.c_str());
+      // Use the Steam launch key to workaround some parsing issue or another...
+      // TODO: Fix this shit -- it's a shitty workaround for stupid duplicate parsing!
+      //       AND it breaks Instant Play custom options... :(
+      auto& launch_cfg =
+        data.launch_configs [launch_idx_steam]; 
 
-          // If we cannot find an extension, or if it's not .exe, flag the launch config as invalid
-          if (pwszExtension == NULL || (pwszExtension + 1) == NULL || _wcsicmp (pwszExtension, L".exe") != 0)
-            launch.valid = 0;
+      launch_cfg.id       = launch_idx_skif;
+      launch_cfg.id_steam = launch_idx_steam;
 
-          // Clean valid executable paths
-          if (launch.valid)
-            launch.executable = std::filesystem::path(launch.executable).lexically_normal();
+      for (auto& key : keys)
+      {
+        switch (key.id)
+        {
+          case _KeyId::oslist:
+            if (StrStrIA ((const char *)key.value, "windows"))
+            {
+              app_record_s::addSupportFor (
+                launch_cfg.platforms,
+                                          app_record_s::Platform::Windows
+                );
+            }
 
-          // Flag duplicates...
-          //   but not if we found them as not valid above (as that would filter out custom launch configs that matches beta launch configs...)
-          if (launch.isExecutableFileNameValid() && launch.valid)
-          {
-            // Use the executable to identify duplicates (affects Disable Special K menu)
-            if (! _used_executables.emplace (launch.getExecutableFileName()).second)
-              launch.duplicate_exe = true;
+            else
+              launch_cfg.platforms =
+                app_record_s::Platform::Unknown;
+            break;
 
-            // Use a combination of the executable and arguments to identify duplicates (affects Instant Play menu)
-            if (! _used_executables_arguments.emplace (launch.getExecutableFileName() + launch.getLaunchOptions()).second)
-              launch.duplicate_exe_args = true;
-          }
+          case _KeyId::osarch:
+            // OS Arch? More like CPU Arch...
+            launch_cfg.cpu_type =
+              _ParseOSArch (key);
+            break;
 
-          // Working dir = empty, ., / or \ all need fixups
-          if ( wcslen (launch.working_dir.c_str ()) < 2 )
+          case _KeyId::betakey:
           {
-            if ( launch.working_dir [0] == L'/'  ||
-                 launch.working_dir [0] == L'\\' ||
-                 launch.working_dir [0] == L'.'  ||
-                 launch.working_dir [0] == L'\0' )
-            {
-              launch.working_dir.clear();
-            }
+            // Populate required betas for this launch option
+            std::istringstream betas((const char *)key.value);
+            std::string beta;
+            while (std::getline (betas, beta, ' '))
+              launch_cfg.branches.emplace (beta);
+            break;
           }
 
-          // Fix working directories
-          // TODO: Test this out properly with games with different working directories set!
-          //       See if there's any games that uses different working directories between launch configs, but otherwise the same executable and cmd-line arguments!
-          if (! launch.working_dir.empty())
-          {
-            launch.working_dir = std::wstring (pAppRecord->install_dir + LR"(\)" + launch.working_dir + L"\0\0");
-            launch.working_dir = std::filesystem::path(launch.working_dir).lexically_normal();
-          }
+          case _KeyId::type:
+            if (! _stricmp ((char *)key.value,      "default"))
+              launch_cfg.type =
+                app_record_s::launch_config_s::Type::Default;
 
-          // Flag the launch config to be added back
-          _launches.push_back (launch);
-        }
-        
-        pAppRecord->launch_configs.clear ();
+            else if (! _stricmp ((char *)key.value, "option1"))
+              launch_cfg.type =
+                app_record_s::launch_config_s::Type::Option1;
 
-        for ( auto& launch : _launches )
-        {
-          // Reset SKIF's internal identifer for the launch configs
-          launch.id = 
-            static_cast<int> (pAppRecord->launch_configs.size());
-          
-#if 0
+            else if (! _stricmp ((char *)key.value, "option2"))
+              launch_cfg.type =
+                app_record_s::launch_config_s::Type::Option2;
 
-          PLOG_VERBOSE << "SKIF  Launch ID   : " <<       launch.id;
-          PLOG_VERBOSE << "Steam Launch ID   : " <<       launch.id_steam;
-          PLOG_VERBOSE << "Executable        : " <<       launch.executable;
-          PLOG_VERBOSE << "Arguments         : " <<       launch.launch_options;
-          PLOG_VERBOSE << "Working Directory : " <<       launch.working_dir;
-          PLOG_VERBOSE << "Launch Type       : " << (int) launch.type;
-          PLOG_VERBOSE << "Description       : " <<       launch.description;
-          PLOG_VERBOSE << "Operating System  : " << (int) launch.platforms;
-          PLOG_VERBOSE << "CPU Architecture  : " << (int) launch.cpu_type;
-          PLOG_VERBOSE << "Beta key          : " <<       launch.beta_key;
-          PLOG_VERBOSE << "Owns DLC          : " <<       launch.owns_dlc;
+            else if (! _stricmp ((char *)key.value, "option3"))
+              launch_cfg.type =
+                app_record_s::launch_config_s::Type::Option3;
 
-#endif
+            else if (! _stricmp ((char *)key.value, "none"))
+              launch_cfg.type =
+                app_record_s::launch_config_s::Type::Unspecified;
+            break;
+
+          // Widechar strings (external)
+          case _KeyId::executable:
+            launch_cfg.executable     = SK_UTF8ToWideChar ((const char *)key.value);
+            break;
+          case _KeyId::arguments:
+            launch_cfg.launch_options = SK_UTF8ToWideChar ((const char *)key.value);
+            break;
+          case _KeyId::description:
+            launch_cfg.description    = SK_UTF8ToWideChar ((const char *)key.value);
+            break;
+          case _KeyId::workingdir:
+            launch_cfg.working_dir    = SK_UTF8ToWideChar ((const char *)key.value);
+            break;
+
+          // UTF8 strings (internal only)
+          case _KeyId::ownsdlc:
+            launch_cfg.requires_dlc   =                    (const char *)key.value;
+            break;
 
-          // Add it back
-          pAppRecord->launch_configs.emplace (
-            static_cast<int> (pAppRecord->launch_configs.size()),
-            launch);
+          default:
+            break;
         }
+      }
+    }
 
-        // Naively move the first Default launch config type to the front
-        int firstValidFound = -1;
+    if ( path == _PathId::RootOverride )
+    {
+      appinfo_data_s::root_override_s
+                     root_override;
 
-        for (auto& launch : pAppRecord->launch_configs)
+      for ( auto& key : keys )
+      {
+        if (key.id == _KeyId::os)
         {
-          // Ignore launch options requiring a beta key
-          // TODO: Contemplate this choice now that SKIF can read current beta!
-          if (! launch.second.branches.empty())
-            continue;
-
-          if (launch.second.type == app_record_s::launch_config_s::Type::Default)
+          if (_stricmp ((char *)key.value, "windows"))
           {
-            firstValidFound = launch.first;
+            root_override = { };
             break;
           }
         }
 
-        if (firstValidFound != -1)
-        {
-          app_record_s::launch_config_s copy             = pAppRecord->launch_configs[0];
-          pAppRecord->launch_configs[0]                  = pAppRecord->launch_configs[firstValidFound];
-          pAppRecord->launch_configs[firstValidFound]    = copy;
-
-          // Swap the internal identifers that SKIF uses (default becomes 0, not-default becomes not)
-          int copy_id                                    = pAppRecord->launch_configs[0].id;
-          pAppRecord->launch_configs[0].id               = 0;
-          pAppRecord->launch_configs[firstValidFound].id = copy_id;
-        }
-#if 0
+        else if (key.id == _KeyId::addpath)
+          root_override.add_path    =
+            SK_UTF8ToWideChar ((char *)key.value) + LR"(\)";
 
-        for (auto& launch : pAppRecord->launch_configs)
+        else if (key.id == _KeyId::root)
+          root_override.root        = (char *)key.value;
+
+        else if (key.id == _KeyId::useinstead)
+          root_override.use_instead = (char *)key.value;
+      }
+
+      if (! root_override.root.empty ())
+        data.root_overrides.push_back (root_override);
+    }
+
+    if ( path == _PathId::Branch )
+    {
+      app_record_s::branch_record_s
+        branch = { };
+
+      int matches = 0;
+
+      for ( auto& key : keys )
+      {
+        switch (key.id)
         {
-          PLOG_VERBOSE << "SKIF  Launch ID   : " <<       launch.second.id;
-          PLOG_VERBOSE << "Steam Launch ID   : " <<       launch.second.id_steam;
-          PLOG_VERBOSE << "Executable        : " <<       launch.second.executable;
-          PLOG_VERBOSE << "Arguments         : " <<       launch.second.launch_options;
-          PLOG_VERBOSE << "Working Directory : " <<       launch.second.working_dir;
-          PLOG_VERBOSE << "Launch Type       : " << (int) launch.second.type;
-          PLOG_VERBOSE << "Description       : " <<       launch.second.description;
-          PLOG_VERBOSE << "Operating System  : " << (int) launch.second.platforms;
-          PLOG_VERBOSE << "CPU Architecture  : " << (int) launch.second.cpu_type;
-          PLOG_VERBOSE << "Beta key          : " <<       launch.second.beta_key;
-          PLOG_VERBOSE << "Owns DLC          : " <<       launch.second.owns_dlc;
+          case _KeyId::buildid:
+            branch.build_id     = *(uint32_t *)key.value, ++matches;
+            break;
+          case _KeyId::pwdrequired:
+            branch.pwd_required = *(uint32_t *)key.value, ++matches;
+            break;
+          case _KeyId::timeupdated:
+            branch.time_updated = *(uint32_t *)key.value, ++matches;
+            break;
+          case _KeyId::description:
+            branch.description  =
+              SK_UTF8ToWideChar ((char *)key.value), ++matches;
+            break;
+          default:
+            break;
         }
+      }
 
-#endif
+      if (matches > 0)
+        data.branches [tape.name [row]] = branch;
+    }
 
-        std::map <std::string, std::wstring> roots = {
-          { "WinMyDocuments",        _path_cache.my_documents.path          },
-          { "WinAppDataLocal",       _path_cache.app_data_local.path        },
-          { "WinAppDataLocalLow",    _path_cache.app_data_local_low.path    },
-          { "WinAppDataRoaming",     _path_cache.app_data_roaming.path      },
-          { "WinSavedGames",         _path_cache.win_saved_games.path       },
-          { "App Install Directory", pAppRecord->install_dir                },
-          { "gameinstall",           pAppRecord->install_dir                },
-          { "SteamCloudDocuments",   L"<Steam Cloud Docs>"                  }
-        };
+    if ( path == _PathId::UFS )
+    {
+      for ( auto& ufs_key : keys )
+      {
+        if (ufs_key.id == _KeyId::hidecloudui)
+        {
+          data.hide_cloud_ui =
+            (*(uint32_t *)ufs_key.value) != 0;
+        }
+      }
+    }
 
-        std::wstring account_id_str   = L"anonymous";
+    else if ( path == _PathId::SaveFile ||
+              path == _PathId::SaveFilePlatforms )
+    {
+      int cloud_idx = 0;
 
-        std::wstring cloud_path       =
-          SK_FormatStringW (      LR"(%ws\userdata\%ws\%d\)",
-              _path_cache.steam_install, account_id_str.c_str (),
-                                             appid );
+      const uint32_t entry_row =
+        section.entryOf (row, _PathId::SaveFiles);
 
-        roots ["SteamCloudDocuments"] =
-          cloud_path;
+      if (entry_row != appinfo_s::section_s::_NoParent)
+        std::sscanf (tape.name [entry_row], "%d", &cloud_idx);
 
-        for (auto& finished_section : section.finished_sections)
+      if (path == _PathId::SaveFilePlatforms)
+      {
+        for (auto& platform : keys)
         {
-          if (finished_section.keys.empty ())
-            continue;
-
-          if (pAppRecord != nullptr)
+          if (data.save_files.count (cloud_idx) != 0)
           {
-            if ( populate_cloud_saves &&
-                   0 ==
-                     finished_section.name.find ("appinfo.ufs.rootoverrides.") )
-            {
-              std::wstring ufs_root;
-              std::wstring use_instead;
-              std::wstring add_path;
-
-              std::unordered_map <std::string, std::wstring*>
-                string_map = {
-                  { "root",       &ufs_root    },
-                  { "useinstead", &use_instead },
-                  { "addpath",    &add_path    }
-                };
-
-              for ( auto& key : finished_section.keys )
-              {
-                if (! _stricmp (key.first, "os"))
-                {
-                  if (_stricmp ((char *)key.second.second, "windows"))
-                  {
-                    ufs_root.clear    ();
-                    add_path.clear    ();
-                    use_instead.clear ();
-                    break;
-                  }
-                }
-
-                else
-                {
-                  std::wstring* pStr = nullptr;
-
-                  auto it =
-                    string_map.find (key.first);
-
-                  if (it != string_map.cend ())
-                    pStr = it->second;
-
-                  if (pStr != nullptr)
-                     *pStr = SK_UTF8ToWideChar ((char *)key.second.second);
-
-                  if (pStr == &add_path)
-                    add_path += LR"(\)";
-                }
-              }
-
-              if (! ufs_root.empty ())
-              {
-                auto utf8_ufs_root =
-                  SK_WideCharToUTF8 (ufs_root);
-
-                if (! use_instead.empty ())
-                { // Some games have overrides that don't override anything
-                  if (! use_instead._Equal (ufs_root))
-                  {
-                    auto utf8_use_instead =
-                      SK_WideCharToUTF8 (use_instead);
-
-                    roots [utf8_ufs_root] = roots.count (utf8_use_instead) != 0 ?
-                                                  roots [utf8_use_instead]      :
-                                                              use_instead;
-                  }
-                }
-
-                if (! add_path.empty ())
-                {
-                  roots [utf8_ufs_root] += add_path;
-                }
-              }
-            }
+            const char* szPlatform =
+              (const char *)platform.value;
 
-            if ( populate_branches &&
-                                 0 ==
-                   finished_section.name.find ("appinfo.depots.branches."))
-            {
-              std::string branch_name =
-                finished_section.name.substr (24);
-
-              auto *branch_ptr =
-                &pAppRecord->branches [branch_name];
-
-
-              static const
-                std::unordered_map <std::string, ptrdiff_t>
-                  int_map = {
-                    { "buildid",     offsetof (app_record_s::branch_record_s, build_id)     },
-                    { "pwdrequired", offsetof (app_record_s::branch_record_s, pwd_required) },
-                    { "timeupdated", offsetof (app_record_s::branch_record_s, time_updated) }
-                  };
-
-              static const
-                std::unordered_map <std::string, ptrdiff_t>
-                  str_map = {
-                    { "description", offsetof (app_record_s::branch_record_s, description) }
-                  };
-
-              int matches = 0;
-
-              for ( auto& key : finished_section.keys )
-              {
-                auto pInt =
-                  int_map.find (key.first);
-
-                if (pInt != int_map.cend ())
-                  *(uint32_t *)VOID_OFFSET (branch_ptr,pInt->second) =
-                    *(uint32_t *)key.second.second, ++matches;
-
-                else
-                {
-                  auto pStr =
-                    str_map.find (key.first);
-
-                  if (pStr != str_map.cend ()) {
-                     *(std::wstring *)VOID_OFFSET (branch_ptr,pStr->second) =
-                       SK_UTF8ToWideChar (
-                         (char *)key.second.second
-                       ), ++matches;
-                  }
-                }
-              }
-
-              if (matches > 0)
-                pAppRecord->branches       [branch_name].parent = pAppRecord;
-              else
-                pAppRecord->branches.erase (branch_name);
-            }
+            auto& platforms =
+              data.save_files [cloud_idx].platforms;
+
+            if      (! strcmp (szPlatform, "windows")) platforms = app_record_s::Platform::Windows;
+            else if (! strcmp (szPlatform, "linux"))   platforms = app_record_s::Platform::Linux;
+            else if (! strcmp (szPlatform, "mac"))     platforms = app_record_s::Platform::Mac;
+            else if (! strcmp (szPlatform, "all"))     platforms = app_record_s::Platform::All;
           }
         }
+      }
 
-        for ( auto& finished_section : section.finished_sections )
+      else
+      {
+        for (auto& key : keys)
         {
-          if (finished_section.keys.empty ())
-            continue;
-
-          if (pAppRecord != nullptr)
+          if (key.id == _KeyId::root)
           {
-            if ( populate_cloud_saves &&
-                                    0 ==
-                   finished_section.name.find ("appinfo.ufs") )
+            auto& save_file =
+              data.save_files [cloud_idx];
 
-            {
-              if (finished_section.name._Equal ("appinfo.ufs"))
-              {
-                for ( auto& ufs_key : finished_section.keys )
-                {
-                  if (! _stricmp (ufs_key.first, "hidecloudui"))
-                  {
-                    pAppRecord->cloud_enabled =
-                      (*(uint32_t *)ufs_key.second.second) == 0;
-                  }
-                }
-              }
-
-              else if (0 == finished_section.name.find ("appinfo.ufs.savefiles."))
-              {
-                int cloud_idx = 0;
-
-                std::sscanf (
-                  finished_section.name.c_str (),
-                    "appinfo.ufs.savefiles.%d",
-                      &cloud_idx
-                );
+            save_file.root     = (const char *)key.value;
+            save_file.has_root = true;
+          }
 
-                static const
-                  std::unordered_map <std::string, app_record_s::Platform>
-                    platform_map = {
-                      { "windows", app_record_s::Platform::Windows },
-                      { "linux",   app_record_s::Platform::Linux   },
-                      { "mac",     app_record_s::Platform::Mac     },
-                      { "all",     app_record_s::Platform::All     }
-                    };
-
-                if (finished_section.name.find ("platforms") != std::string::npos)
-                {
-                  for (auto& platform : finished_section.keys)
-                  {
-                    if (pAppRecord->cloud_saves.count (cloud_idx) != 0)
-                    {
-                      try
-                      {
-                        pAppRecord->cloud_saves [cloud_idx].platforms =
-                          platform_map.at ((const char *)platform.second.second);
-                      }
-                      catch (const std::out_of_range& e) { UNREFERENCED_PARAMETER (e); };
-                    }
-                  }
-                }
-
-                else
-                {
-                  for (auto& key : finished_section.keys)
-                  {
-                    if (! _stricmp (key.first, "root"))
-                    {
-                      pAppRecord->cloud_saves [cloud_idx].root =
-                        roots [(const char *)key.second.second];
-                    }
-
-                    else if (! _stricmp (key.first, "path"))
-                    {
-                      auto replaceSpecialValues = []
-                      (       std::wstring& str,
-                        const std::wstring& special,
-                        const std::wstring& substitute )
-                      {
-                        if (special.empty ())
-                          return;
-
-                        size_t start_pos = 0;
-
-                        while ((start_pos = str.find (special, start_pos)) != std::string::npos)
-                        {
-                          str.replace (
-                            start_pos, special.length (),
-                            substitute
-                          );
-                          start_pos += substitute.length ();
-                        }
-                      };
-
-                      auto& rkCloudSave =
-                        pAppRecord->cloud_saves [cloud_idx];
-
-                      rkCloudSave.path =
-                        SK_UTF8ToWideChar ((const char *)key.second.second);
-
-                      static unsigned long Steam3AccountID = 0UL;
-                      static uint64        Steam64BitID    = 0ULL;
-
-                      static auto
-                        CacheAccountIDs =
-                         [&](void)
-                          {
-                            WCHAR                    szData [255] = { };
-                            DWORD   dwSize = sizeof (szData);
-                            PVOID   pvData =         szData;
-                            CRegKey hKey ((HKEY)0);
-
-                            if (RegOpenKeyExW (HKEY_CURRENT_USER, LR"(SOFTWARE\Valve\Steam\ActiveProcess\)", 0, KEY_READ, &hKey.m_hKey) == ERROR_SUCCESS)
-                            {
-                              if (RegGetValueW (hKey, NULL, L"ActiveUser", RRF_RT_REG_DWORD, NULL, pvData, &dwSize) == ERROR_SUCCESS)
-                                Steam3AccountID = *(DWORD*)pvData;
-                            }
-
-                            Steam64BitID = std::stoull (
-                              SK_UseManifestToGetAppOwner (pAppRecord));
-                          };
-
-                        SK_RunOnce (
-                          CacheAccountIDs ()
-                        );
-
-                      replaceSpecialValues ( rkCloudSave.path,
-                                             L"{64BitSteamID}",
-                               std::to_wstring (Steam64BitID) );
-
-                      replaceSpecialValues ( rkCloudSave.path,
-                                                          L"{Steam3AccountID}",
-                                            std::to_wstring (Steam3AccountID) );
-                    }
-                  }
-                }
-              }
-            }
+          else if (key.id == _KeyId::path)
+          {
+            auto& save_file =
+              data.save_files [cloud_idx];
+
+            save_file.path     = SK_UTF8ToWideChar ((const char *)key.value);
+            save_file.has_path = true;
           }
+        }
+      }
+    }
 
 #ifdef _WRITE_APPID_INI
-          fprintf (fTest, "[%s]\n", finished_section.name.c_str ());
+    fprintf (fTest, "[%*s%s] ; path=%d\n", tape.depth [row] * 2, "", tape.name [row], path);
 
-          for ( auto& datum : finished_section.keys )
-          {
-            if (datum.second.first == appinfo_s::section_s::String)
-              fprintf (fTest, "%s=%s\n",   datum.first,  (char     *)datum.second.second);
-            else if (datum.second.first == appinfo_s::section_s::Int32)
-              fprintf (fTest, "%s=%lu\n",  datum.first, *(uint32_t *)datum.second.second);
-            else if (datum.second.first == appinfo_s::section_s::Int64)
-              fprintf (fTest, "%s=%llu\n", datum.first, *(uint64_t *)datum.second.second);
-          }
-          fprintf (fTest, "\n");
+    for ( auto& datum : keys )
+    {
+      if (datum.op == appinfo_s::section_s::String)
+        fprintf (fTest, "%s=%s\n",   datum.name,  (char     *)datum.value);
+      else if (datum.op == appinfo_s::section_s::Int32)
+        fprintf (fTest, "%s=%lu\n",  datum.name, *(uint32_t *)datum.value);
+      else if (datum.op == appinfo_s::section_s::Int64)
+        fprintf (fTest, "%s=%llu\n", datum.name, *(uint64_t *)datum.value);
+    }
+    fprintf (fTest, "\n");
 #endif
+  }
+
+#ifdef _WRITE_APPID_INI
+  fclose (fTest);
+#endif
+
+  return (! section.exception);
+}
+
+void
+skValveDataFile::_applyAppInfo (app_record_s* pAppRecord, const appinfo_data_s& data)
+{
+  static SKIF_CommonPathsCache& _path_cache = SKIF_CommonPathsCache::GetInstance ( );
+
+  const uint32_t appid =
+    pAppRecord->id;
+
+  bool populate_appinfo_extended =
+    pAppRecord->extended_config.vac.enabled == -1;
+  bool populate_common =
+    pAppRecord->common_config.appid == 0;
+  bool populate_cloud_saves =
+    pAppRecord->cloud_saves.empty ();
+
+  bool populate_branches  =
+    pAppRecord->branches.empty ();
+
+  bool populate_launch_configs =
+    pAppRecord->launch_configs.empty ();
+
+  pAppRecord->install_dir =
+    SK_UseManifestToGetInstallDir (pAppRecord);
+
+  if (populate_appinfo_extended)
+  {
+    auto *pVac =
+      &pAppRecord->extended_config.vac;
+
+    pVac->vacmodulefilename = data.vac_module;
+    pVac->enabled           = (! data.vac_module.empty ());
+  }
+
+  if (populate_common && data.has_common)
+  {
+    pAppRecord->common_config.appid     = pAppRecord->id;
+    pAppRecord->common_config.cpu_type  = data.common.cpu_type;
+    pAppRecord->common_config.type      = data.common.type;
+    pAppRecord->common_config.icon_hash = data.common.icon_hash;
+  }
+
+  // If the appinfo.vdf didn't contain library asset paths, default to standard path
+  pAppRecord->common_config.boxart_hash =
+    data.common.boxart_hash.empty () ? "library_600x900.jpg"
+                                     : data.common.boxart_hash;
+
+  if (populate_launch_configs)
+    pAppRecord->launch_configs = data.launch_configs;
+
+  // At this point, since we used Steam's index as the position to stuff data into, the vector has
+  //   has objects all over -- some at 0, some at 1, others at 0-4, not 5, 6-9. Basically we cannot
+  //     be certain of anything, at all, what so bloody ever! So let's just recreate the std::map!
+
+  std::vector <app_record_s::launch_config_s> _cleaner;
+
+  // Put away put away put away put away
+  for ( auto& keep : pAppRecord->launch_configs )
+    _cleaner.push_back (keep.second);
+  
+  // Clean clean clean clean!
+  pAppRecord->launch_configs.clear ();
+
+  // Restore restore restore restore!
+  for ( auto& launch : _cleaner )
+  {
+    // Reset SKIF's internal identifer for the launch configs
+    launch.id = 
+      static_cast<int> (pAppRecord->launch_configs.size());
+
+    // Add it back
+    pAppRecord->launch_configs.emplace (
+      static_cast<int> (pAppRecord->launch_configs.size()),
+      launch);
+  }
+  // std::map is now reliable again!
+
+  std::set    <std::wstring>          _used_executables;
+  std::set    <std::wstring>          _used_executables_arguments;
+  std::vector <app_record_s::launch_config_s> _launches;
+
+  // Now add in our custom launch configs!
+  for (auto& custom_cfg : pAppRecord->launch_configs_custom)
+  {
+    custom_cfg.second.id =
+      static_cast<int> (pAppRecord->launch_configs.size());
+
+    // Custom launch config, so Steam launch ID is nothing we use
+    custom_cfg.second.id_steam = -1;
+
+    if (! pAppRecord->launch_configs.emplace (custom_cfg.second.id, custom_cfg.second).second)
+      PLOG_ERROR << "Failed adding a custom launch config to the launch map. An element at that position already exists!";
+  }
+
+  // The custom launches are kept around (rather than cleared out once populated)
+  //   so they can be merged in again if the app is reprocessed, see resetApp ( )
+
+  for ( auto& launch_cfg : pAppRecord->launch_configs )
+  {
+    auto& launch = launch_cfg.second;
+
+    // Summarize the branches in a comma-delimited string as well
+    if (! launch.branches.empty())
+    {
+      for (auto const& branch : launch.branches)
+        launch.branches_joined += branch + ", ";
+
+      // Remove trailing comma and space
+      launch.branches_joined.pop_back();
+      launch.branches_joined.pop_back();
+    }
+
+    // Filter launch configurations for other OSes
+    if ( (! app_record_s::supports (launch.platforms,
+                             app_record_s::Platform::Windows) ))
+      continue;
+
+    // Filter launch configurations lacking an executable
+    // This also skips all the semi-weird duplicate launch configs SKIF randomly creates
+    if (launch.executable.empty())
+      continue;
+
+    // Filter launch configurations requiring a beta branch that the user do not have
+    if (! launch.branches.empty() && launch.branches.count (pAppRecord->steam.branch) == 0)
+      launch.valid = 0;
+
+    // File extension, so we can flag out non-executable ones (e.g. link2ea)
+    const wchar_t* pwszExtension =
+      PathFindExtension (launch.executable.c_str());
+
+    // If we cannot find an extension, or if it's not .exe, flag the launch config as invalid
+    if (pwszExtension == NULL || (pwszExtension + 1) == NULL || _wcsicmp (pwszExtension, L".exe") != 0)
+      launch.valid = 0;
+
+    // Clean valid executable paths
+    if (launch.valid)
+      launch.executable = std::filesystem::path(launch.executable).lexically_normal();
+
+    // Flag duplicates...
+    //   but not if we found them as not valid above (as that would filter out custom launch configs that matches beta launch configs...)
+    if (launch.isExecutableFileNameValid() && launch.valid)
+    {
+      // Use the executable to identify duplicates (affects Disable Special K menu)
+      if (! _used_executables.emplace (launch.getExecutableFileName()).second)
+        launch.duplicate_exe = true;
+
+      // Use a combination of the executable and arguments to identify duplicates (affects Instant Play menu)
+      if (! _used_executables_arguments.emplace (launch.getExecutableFileName() + launch.getLaunchOptions()).second)
+        launch.duplicate_exe_args = true;
+    }
+
+    // Working dir = empty, ., / or \ all need fixups
+    if ( wcslen (launch.working_dir.c_str ()) < 2 )
+    {
+      if ( launch.working_dir [0] == L'/'  ||
+           launch.working_dir [0] == L'\\' ||
+           launch.working_dir [0] == L'.'  ||
+           launch.working_dir [0] == L'\0' )
+      {
+        launch.working_dir.clear();
+      }
+    }
+
+    // Fix working directories
+    // TODO: Test this out properly with games with different working directories set!
+    //       See if there's any games that uses different working directories between launch configs, but otherwise the same executable and cmd-line arguments!
+    if (! launch.working_dir.empty())
+    {
+      launch.working_dir = std::wstring (pAppRecord->install_dir + LR"(\)" + launch.working_dir + L"\0\0");
+      launch.working_dir = std::filesystem::path(launch.working_dir).lexically_normal();
+    }
+
+    // Flag the launch config to be added back
+    _launches.push_back (launch);
+  }
+  
+  pAppRecord->launch_configs.clear ();
+
+  for ( auto& launch : _launches )
+  {
+    // Reset SKIF's internal identifer for the launch configs
+    launch.id = 
+      static_cast<int> (pAppRecord->launch_configs.size());
+    
+#if 0
+
+    PLOG_VERBOSE << "SKIF  Launch ID   : " <<       launch.id;
+    PLOG_VERBOSE << "Steam Launch ID   : " <<       launch.id_steam;
+    PLOG_VERBOSE << "Executable        : " <<       launch.executable;
+    PLOG_VERBOSE << "Arguments         : " <<       launch.launch_options;
+    PLOG_VERBOSE << "Working Directory : " <<       launch.working_dir;
+    PLOG_VERBOSE << "Launch Type       : " << (int) launch.type;
+    PLOG_VERBOSE << "Description       : " <<       launch.description;
+    PLOG_VERBOSE << "Operating System  : " << (int) launch.platforms;
+    PLOG_VERBOSE << "CPU Architecture  : " << (int) launch.cpu_type;
+    PLOG_VERBOSE << "Beta key          : " <<       launch.beta_key;
+    PLOG_VERBOSE << "Owns DLC          : " <<       launch.owns_dlc;
+
+#endif
+
+    // Add it back
+    pAppRecord->launch_configs.emplace (
+      static_cast<int> (pAppRecord->launch_configs.size()),
+      launch);
+  }
+
+  // Naively move the first Default launch config type to the front
+  int firstValidFound = -1;
+
+  for (auto& launch : pAppRecord->launch_configs)
+  {
+    // Ignore launch options requiring a beta key
+    // TODO: Contemplate this choice now that SKIF can read current beta!
+    if (! launch.second.branches.empty())
+      continue;
+
+    if (launch.second.type == app_record_s::launch_config_s::Type::Default)
+    {
+      firstValidFound = launch.first;
+      break;
+    }
+  }
+
+  if (firstValidFound != -1)
+  {
+    app_record_s::launch_config_s copy             = pAppRecord->launch_configs[0];
+    pAppRecord->launch_configs[0]                  = pAppRecord->launch_configs[firstValidFound];
+    pAppRecord->launch_configs[firstValidFound]    = copy;
+
+    // Swap the internal identifers that SKIF uses (default becomes 0, not-default becomes not)
+    int copy_id                                    = pAppRecord->launch_configs[0].id;
+    pAppRecord->launch_configs[0].id               = 0;
+    pAppRecord->launch_configs[firstValidFound].id = copy_id;
+  }
+#if 0
+
+  for (auto& launch : pAppRecord->launch_configs)
+  {
+    PLOG_VERBOSE << "SKIF  Launch ID   : " <<       launch.second.id;
+    PLOG_VERBOSE << "Steam Launch ID   : " <<       launch.second.id_steam;
+    PLOG_VERBOSE << "Executable        : " <<       launch.second.executable;
+    PLOG_VERBOSE << "Arguments         : " <<       launch.second.launch_options;
+    PLOG_VERBOSE << "Working Directory : " <<       launch.second.working_dir;
+    PLOG_VERBOSE << "Launch Type       : " << (int) launch.second.type;
+    PLOG_VERBOSE << "Description       : " <<       launch.second.description;
+    PLOG_VERBOSE << "Operating System  : " << (int) launch.second.platforms;
+    PLOG_VERBOSE << "CPU Architecture  : " << (int) launch.second.cpu_type;
+    PLOG_VERBOSE << "Beta key          : " <<       launch.second.beta_key;
+    PLOG_VERBOSE << "Owns DLC          : " <<       launch.second.owns_dlc;
+  }
+
+#endif
+
+  std::map <std::string, std::wstring> roots = {
+    { "WinMyDocuments",        _path_cache.my_documents.path          },
+    { "WinAppDataLocal",       _path_cache.app_data_local.path        },
+    { "WinAppDataLocalLow",    _path_cache.app_data_local_low.path    },
+    { "WinAppDataRoaming",     _path_cache.app_data_roaming.path      },
+    { "WinSavedGames",         _path_cache.win_saved_games.path       },
+    { "App Install Directory", pAppRecord->install_dir                },
+    { "gameinstall",           pAppRecord->install_dir                },
+    { "SteamCloudDocuments",   L"<Steam Cloud Docs>"                  }
+  };
+
+  std::wstring account_id_str   = L"anonymous";
+
+  std::wstring cloud_path       =
+    SK_FormatStringW (      LR"(%ws\userdata\%ws\%d\)",
+        _path_cache.steam_install, account_id_str.c_str (),
+                                       appid );
+
+  roots ["SteamCloudDocuments"] =
+    cloud_path;
+
+  if (populate_cloud_saves)
+  {
+    for (auto& root_override : data.root_overrides)
+    {
+      if (! root_override.use_instead.empty ())
+      { // Some games have overrides that don't override anything
+        if (! root_override.use_instead._Equal (root_override.root))
+        {
+          roots [root_override.root] = roots.count (root_override.use_instead) != 0 ?
+                                              roots [root_override.use_instead]      :
+                                          SK_UTF8ToWideChar (root_override.use_instead);
         }
+      }
+
+      if (! root_override.add_path.empty ())
+      {
+        roots [root_override.root] += root_override.add_path;
+      }
+    }
+  }
+
+  if (populate_branches)
+  {
+    for (auto& branch : data.branches)
+    {
+      auto& record =
+        pAppRecord->branches [branch.first];
+
+      record        = branch.second;
+      record.parent = pAppRecord;
+    }
+  }
+
+  if (populate_cloud_saves)
+  {
+    if (data.hide_cloud_ui != -1)
+      pAppRecord->cloud_enabled = (data.hide_cloud_ui == 0);
+
+    auto replaceSpecialValues = []
+    (       std::wstring& str,
+      const std::wstring& special,
+      const std::wstring& substitute )
+    {
+      if (special.empty ())
+        return;
+
+      size_t start_pos = 0;
+
+      while ((start_pos = str.find (special, start_pos)) != std::string::npos)
+      {
+        str.replace (
+          start_pos, special.length (),
+          substitute
+        );
+        start_pos += substitute.length ();
+      }
+    };
 
-        if (pAppRecord != nullptr)
+    for (auto& save_file : data.save_files)
+    {
+      auto& rkCloudSave =
+        pAppRecord->cloud_saves [save_file.first];
+
+      rkCloudSave.platforms =
+        save_file.second.platforms;
+
+      if (save_file.second.has_root)
+        rkCloudSave.root =
+          roots [save_file.second.root];
+
+      if (save_file.second.has_path)
+      {
+        rkCloudSave.path =
+          save_file.second.path;
+
+        static unsigned long Steam3AccountID = 0UL;
+        static uint64        Steam64BitID    = 0ULL;
+
+        // Multiple appinfo workers may get here at the same time
+        static std::once_flag
+          account_ids_cached;
+
+        std::call_once (account_ids_cached, [&](void)
         {
-          std::set <std::wstring> _used_paths;
+          WCHAR                    szData [255] = { };
+          DWORD   dwSize = sizeof (szData);
+          PVOID   pvData =         szData;
+          CRegKey hKey ((HKEY)0);
 
-          for ( auto& cloud_save : pAppRecord->cloud_saves )
+          if (RegOpenKeyExW (HKEY_CURRENT_USER, LR"(SOFTWARE\Valve\Steam\ActiveProcess\)", 0, KEY_READ, &hKey.m_hKey) == ERROR_SUCCESS)
           {
-            // This only needs to be done once per-game, per-cloud path
-            if (! cloud_save.second.evaluated_dir.empty ())
-              continue;
+            if (RegGetValueW (hKey, NULL, L"ActiveUser", RRF_RT_REG_DWORD, NULL, pvData, &dwSize) == ERROR_SUCCESS)
+              Steam3AccountID = *(DWORD*)pvData;
+          }
 
-            wchar_t     wszTestPath [MAX_PATH + 2] = { };
-            wnsprintf ( wszTestPath, MAX_PATH,
-                          L"%s\\%s", cloud_save.second.root.c_str (),
-                                     cloud_save.second.path.c_str () );
+          // An exception escaping here would take down the worker thread
+          Steam64BitID = std::strtoull (
+            SK_UseManifestToGetAppOwner (pAppRecord).c_str (), nullptr, 10);
+        });
 
-            SK_FixSlashesW           (wszTestPath);
-            SK_StripTrailingSlashesW (wszTestPath);
-            SK_StripLeadingSlashesW  (wszTestPath);
+        replaceSpecialValues ( rkCloudSave.path,
+                               L"{64BitSteamID}",
+                 std::to_wstring (Steam64BitID) );
 
-            cloud_save.second.evaluated_dir =
-              wszTestPath;
+        replaceSpecialValues ( rkCloudSave.path,
+                                            L"{Steam3AccountID}",
+                              std::to_wstring (Steam3AccountID) );
+      }
+    }
+  }
 
-            // Skip duplicate Auto-Cloud entries
-            if (! _used_paths.emplace (cloud_save.second.evaluated_dir).second)
-              continue;
-          }
+  std::set <std::wstring> _used_paths;
 
-          // Steam requires we resolve executable_path here as well
-          for ( auto& launch_cfg : pAppRecord->launch_configs )
-          {
-            if (! pAppRecord->install_dir.empty())
-            {
-              launch_cfg.second.install_dir = pAppRecord->install_dir;
-              
-              // EA games using link2ea:// protocol handlers to launch games does not have an executable,
-              //  so this ensures we do not end up testing the installation folder instead (since this has
-              //   bearing on whether a launch config is deemed valid or not as part of the blacklist check)
-              if (launch_cfg.second.isExecutableFileNameValid ( ))
-              {
-                launch_cfg.second.executable_path = launch_cfg.second.install_dir;
-                launch_cfg.second.executable_path.append (L"\\");
-                launch_cfg.second.executable_path.append (launch_cfg.second.getExecutableFileName ( ));
-              }
-            }
+  for ( auto& cloud_save : pAppRecord->cloud_saves )
+  {
+    // This only needs to be done once per-game, per-cloud path
+    if (! cloud_save.second.evaluated_dir.empty ())
+      continue;
 
-            // Populate empty launch descriptions as well
-            if (launch_cfg.second.description.empty())
-            {
-              launch_cfg.second.description      = SK_UTF8ToWideChar (pAppRecord->names.normal);
-              launch_cfg.second.description_utf8 = pAppRecord->names.normal;
-            }
-          }
-        }
+    wchar_t     wszTestPath [MAX_PATH + 2] = { };
+    wnsprintf ( wszTestPath, MAX_PATH,
+                  L"%s\\%s", cloud_save.second.root.c_str (),
+                             cloud_save.second.path.c_str () );
 
-#ifdef _WRITE_APPID_INI
-        fclose (fTest);
-#endif
+    SK_FixSlashesW           (wszTestPath);
+    SK_StripTrailingSlashesW (wszTestPath);
+    SK_StripLeadingSlashesW  (wszTestPath);
 
-        if (pAppRecord != nullptr)
-          pAppRecord->processed = true;
+    cloud_save.second.evaluated_dir =
+      wszTestPath;
 
-        return pIter;
+    // Skip duplicate Auto-Cloud entries
+    if (! _used_paths.emplace (cloud_save.second.evaluated_dir).second)
+      continue;
+  }
+
+  // Steam requires we resolve executable_path here as well
+  for ( auto& launch_cfg : pAppRecord->launch_configs )
+  {
+    if (! pAppRecord->install_dir.empty())
+    {
+      launch_cfg.second.install_dir = pAppRecord->install_dir;
+      
+      // EA games using link2ea:// protocol handlers to launch games does not have an executable,
+      //  so this ensures we do not end up testing the installation folder instead (since this has
+      //   bearing on whether a launch config is deemed valid or not as part of the blacklist check)
+      if (launch_cfg.second.isExecutableFileNameValid ( ))
+      {
+        launch_cfg.second.executable_path = launch_cfg.second.install_dir;
+        launch_cfg.second.executable_path.append (L"\\");
+        launch_cfg.second.executable_path.append (launch_cfg.second.getExecutableFileName ( ));
       }
+    }
 
-      pIter =
-        pIter->getNextApp ();
+    // Populate empty launch descriptions as well
+    if (launch_cfg.second.description.empty())
+    {
+      launch_cfg.second.description      = SK_UTF8ToWideChar (pAppRecord->names.normal);
+      launch_cfg.second.description_utf8 = pAppRecord->names.normal;
     }
   }
+}
 
-  return nullptr;
-}
\ No newline at end of file
@@ -0,0 +1,1152 @@
+//
+// Copyright 2020-2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <stores/Steam/vdf.h>
+#include <stores/Steam/vdf_internal.h>
+#include <plog/Log.h>
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
+// Loading, indexing and parsing of appinfo.vdf. Needs nothing but the Win32
+//   file and mapping functions, so tests/ can build it against a shim of those
+
+// Shorthands, to make life less painful
+using appinfo_s     = skValveDataFile::appinfo_s;
+using app_section_s =                  appinfo_s::section_s;
+
+uint32_t skValveDataFile::vdf_version = 0x27; // Default to Pre-December 2022
+
+skValveDataFile::skValveDataFile (std::wstring source, LoadMode mode) : path (source)
+{
+  _file = std::make_unique <file_s> ();
+  _mode = mode;
+
+  bool loaded =
+    (mode == LoadMode::Mapped)   ? _loadMapped   ( ) :
+    (mode == LoadMode::Windowed) ? _loadWindowed ( ) :
+                                   false;
+
+  // Fall back to reading the file into memory if the mapping failed
+  //   (e.g. SKIF32 running out of contiguous address space)
+  if (! loaded)
+  {
+    _mode  = LoadMode::Buffered;
+    loaded = _loadBuffered ( );
+  }
+
+  if (loaded)
+  {
+    // The file was opened on behalf of indexing, which is done with it after this
+    _file->users = 1;
+
+    _indexFile   ( );
+     releaseFile ( );
+  }
+}
+
+skValveDataFile::~skValveDataFile (void)
+{
+  // Workers reference the mapped file, so they have to be gone first
+  _cancelBatch ( );
+  _cacheSave   ( );
+  _closeFile   ( );
+
+  _window.reset ();
+}
+
+void
+skValveDataFile::_indexFile (void)
+{
+  if (_size > sizeof (header_s) + sizeof (uint64_t))
+  {
+    BYTE* pHeader =
+      _acquireView (0, sizeof (header_s) + sizeof (uint64_t));
+
+    if (pHeader == nullptr)
+      return;
+
+    vdf_version =
+      pHeader [0];
+
+    _root_ofs =
+      offsetof (header_s, head);
+
+    uint64_t strtable_pos = 0;
+
+    // A string table was added in June of 2024 (0x29)
+    if (vdf_version >= 0x29)
+    {
+      strtable_pos = *(uint64_t *)(pHeader + _root_ofs);
+      _root_ofs   += sizeof (uint64_t);
+    }
+
+    _releaseView (pHeader);
+
+    if (_mem != nullptr)
+    {
+      base =
+        reinterpret_cast <header_s  *> (_mem);
+      root =
+        reinterpret_cast <appinfo_s *> (_mem + _root_ofs);
+    }
+
+    switch (vdf_version)
+    {
+      case 0x29: // v41
+        PLOG_VERBOSE << "appinfo.vdf version: " << vdf_version << " (June 2024)";
+        break;
+      case 0x28: // v40
+        PLOG_VERBOSE << "appinfo.vdf version: " << vdf_version << " (December 2022)";
+        break;
+      case 0x27: // v39
+        PLOG_VERBOSE << "appinfo.vdf version: " << vdf_version << " (pre-December 2022)";
+        break;
+      default:
+        PLOG_WARNING << "appinfo.vdf version: " << vdf_version << " (unknown/unsupported)";
+    }
+
+    if (vdf_version >= 0x29)
+    {
+      if (strtable_pos + sizeof (str_tbl_s::num_strings) >= _size)
+      {
+        PLOG_ERROR << "appinfo.vdf string table lies outside of the file!";
+
+        base = nullptr;
+        root = nullptr;
+
+        return;
+      }
+
+      const uint64_t table_size =
+        _size - strtable_pos;
+
+      BYTE* pTable =
+        (_mode == LoadMode::Buffered) ? _mem + strtable_pos
+                                      : nullptr;
+
+      // The string table is needed for every app, so unless the whole file was read
+      //   into memory the reader keeps its own copy rather than holding on to the file
+      if (_mode != LoadMode::Buffered)
+      {
+        LARGE_INTEGER liPos = { };
+                      liPos.QuadPart = static_cast <LONGLONG> (strtable_pos);
+
+        DWORD dwRead = 0;
+
+        if ( table_size > std::numeric_limits <DWORD>::max () )
+        {
+          PLOG_ERROR << "appinfo.vdf string table is too large!";
+          return;
+        }
+
+        _strtbl.resize (static_cast <size_t> (table_size));
+
+        if (! SetFilePointerEx (_hFile, liPos, nullptr, FILE_BEGIN) ||
+            ! ReadFile         (_hFile, _strtbl.data (), static_cast <DWORD> (table_size), &dwRead, nullptr) ||
+              dwRead != table_size)
+        {
+          PLOG_ERROR << "Failed to read the appinfo.vdf string table, error: " << GetLastError ( );
+
+          _strtbl.clear ();
+
+          return;
+        }
+
+        pTable = _strtbl.data ();
+      }
+
+      table = (str_tbl_s *)pTable;
+
+      strs.reserve   (        table->num_strings);
+      strs.push_back ((char *)table->strings);
+
+      char* str     = (char *)table->strings;
+      char* end_tbl = (char *)pTable + table_size;
+
+      for (DWORD i = 1; i < table->num_strings; ++i)
+      {
+        while (*str++ != '\0' && str < end_tbl);
+
+        if (str > end_tbl)
+        {
+          // On overflow, restart table iteration from the beginning
+          PLOG_ERROR << "Malformed string table detected!";
+          str = (char *)table->strings;
+        }
+
+        strs.push_back (str);
+      }
+
+      // Resolve the keys SKIF is interested in once, rather than per token
+      str_keys.resize (strs.size ());
+
+      for (size_t i = 0; i < strs.size (); i++)
+        str_keys [i] = app_section_s::lookupKey (strs [i]);
+    }
+
+    _buildIndex ( );
+    _cacheLoad  ( );
+  }
+}
+
+bool
+skValveDataFile::acquireFile (void)
+{
+  std::lock_guard <std::mutex> lock (_file->mutex);
+
+  if (_file->users == 0 && _mode != LoadMode::Buffered)
+  {
+    const bool opened =
+      (_mode == LoadMode::Mapped) ? _loadMapped   ( )
+                                  : _loadWindowed ( );
+
+    if (! opened)
+      return false;
+
+    if (_mem != nullptr && ! index.empty ())
+    {
+      base =
+        reinterpret_cast <header_s  *> (_mem);
+      root =
+        reinterpret_cast <appinfo_s *> (_mem + _root_ofs);
+    }
+  }
+
+  _file->users++;
+
+  return true;
+}
+
+void
+skValveDataFile::releaseFile (void)
+{
+  std::lock_guard <std::mutex> lock (_file->mutex);
+
+  if (_file->users == 0)
+    return;
+
+  if (--_file->users == 0)
+    _closeFile ( );
+}
+
+// Steam deletes, renames over and truncates appinfo.vdf while it runs, none of
+//   which it can do while the file is open or mapped. So the file is only open
+//     while it is read from, without sharing write access for that time, and is
+//       not read from again once it differs from the file that was indexed.
+bool
+skValveDataFile::_openFile (void)
+{
+  if (_file->stale)
+    return false;
+
+  _hFile =
+    CreateFileW ( path.c_str (),
+                    GENERIC_READ,
+                      FILE_SHARE_READ | FILE_SHARE_DELETE,
+                        nullptr,        OPEN_EXISTING,
+                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                            nullptr );
+
+  if (_hFile == INVALID_HANDLE_VALUE)
+  {
+    PLOG_WARNING << "Failed to open appinfo.vdf, error: " << GetLastError ( );
+    return false;
+  }
+
+  LARGE_INTEGER liSize    = { };
+  FILETIME      ftWritten = { };
+
+  if ( GetFileSizeEx (_hFile, &liSize) && liSize.QuadPart > 0 &&
+       GetFileTime   (_hFile, nullptr, nullptr, &ftWritten) )
+  {
+    // Opened for the first time, this is the file that gets indexed
+    if (_size == 0)
+    {
+      _size             = static_cast <uint64_t> (liSize.QuadPart);
+      _file->last_write = ftWritten;
+
+      return true;
+    }
+
+    if ( static_cast <uint64_t> (liSize.QuadPart) == _size &&
+         CompareFileTime (&ftWritten, &_file->last_write) == 0 )
+      return true;
+
+    PLOG_WARNING << "appinfo.vdf has changed since it was indexed, it will not be read again";
+
+    _file->stale = true;
+  }
+
+  CloseHandle (_hFile);
+               _hFile = INVALID_HANDLE_VALUE;
+
+  return false;
+}
+
+// All views of the file have to be released by now
+void
+skValveDataFile::_closeFile (void)
+{
+  if (_window != nullptr)
+  {
+    if (_window->view != nullptr)
+      UnmapViewOfFile (_window->view);
+
+    for (auto& temp : _window->temp_views)
+      UnmapViewOfFile (temp.second);
+
+    _window->temp_views.clear ();
+    _window->view   = nullptr;
+    _window->begin  = 0;
+    _window->size   = 0;
+    _window->leases = 0;
+  }
+
+  else if (_hMapping != nullptr)
+  {
+    UnmapViewOfFile (_mem);
+
+    _mem = nullptr;
+    base = nullptr;
+    root = nullptr;
+  }
+
+  if (_hMapping != nullptr)
+    CloseHandle (_hMapping);
+
+  if (_hFile != INVALID_HANDLE_VALUE)
+    CloseHandle (_hFile);
+
+  _hMapping = nullptr;
+  _hFile    = INVALID_HANDLE_VALUE;
+}
+
+bool
+skValveDataFile::_loadMapped (void)
+{
+  if (! _openFile ( ))
+    return false;
+
+  if (_size <= std::numeric_limits <size_t>::max ())
+  {
+    _hMapping =
+      CreateFileMappingW (_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (_hMapping != nullptr)
+    {
+      _mem =
+        static_cast <BYTE *> (
+          MapViewOfFile (_hMapping, FILE_MAP_READ, 0, 0, 0)
+        );
+
+      if (_mem != nullptr)
+        return true;
+
+      PLOG_WARNING << "Failed to map appinfo.vdf into memory, error: " << GetLastError ( );
+
+      CloseHandle (_hMapping);
+                   _hMapping = nullptr;
+    }
+  }
+
+  CloseHandle (_hFile);
+               _hFile = INVALID_HANDLE_VALUE;
+
+  return false;
+}
+
+bool
+skValveDataFile::_loadBuffered (void)
+{
+  FILE *fData = nullptr;
+
+  _wfopen_s (&fData, path.c_str (), L"rbS");
+
+  if (fData == nullptr)
+    return false;
+
+#ifdef _WIN64
+  _fseeki64 (fData, 0, SEEK_END);
+#else
+  fseek     (fData, 0, SEEK_END);
+#endif
+  size_t
+  size =
+#ifdef _WIN64
+  _ftelli64 (fData);
+#else
+  ftell     (fData);
+#endif
+  rewind    (fData);
+
+  _data.resize (size);
+
+  fread  (_data.data (), size, 1, fData);
+  fclose (                        fData);
+
+  _mem  = _data.data ();
+  _size = _data.size ();
+
+  return (_size != 0);
+}
+
+bool
+skValveDataFile::_loadWindowed (void)
+{
+  if (! _openFile ( ))
+    return false;
+
+  // The mapping object itself does not take up any address space, only its views do
+  _hMapping =
+    CreateFileMappingW (_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  if (_hMapping != nullptr)
+  {
+    if (_window == nullptr)
+    {
+      SYSTEM_INFO
+        sysInfo = { };
+      GetSystemInfo (&sysInfo);
+
+      _window = std::make_unique <window_s> ();
+      _window->granularity = sysInfo.dwAllocationGranularity;
+
+      PLOG_VERBOSE << "Reading appinfo.vdf through a " << (WindowSize >> 20) << " MiB window ("
+                   << (_size >> 20) << " MiB file)";
+    }
+
+    return true;
+  }
+
+  CloseHandle (_hFile);
+               _hFile = INVALID_HANDLE_VALUE;
+
+  return false;
+}
+
+BYTE*
+skValveDataFile::_acquireView (uint64_t offset, size_t len)
+{
+  if (offset > _size || len > _size - offset)
+    return nullptr;
+
+  if (_mem != nullptr)
+    return _mem + offset;
+
+  // Nothing to read from while the file is closed
+  if (_window == nullptr || _hMapping == nullptr)
+    return nullptr;
+
+  auto& window = *_window;
+
+  std::lock_guard <std::mutex> lock (window.mutex);
+
+  if (window.view != nullptr && offset >= window.begin &&
+                       offset + len <= window.begin + window.size)
+  {
+    window.leases++;
+
+    return window.view + (offset - window.begin);
+  }
+
+  const uint64_t aligned =
+    offset - (offset % window.granularity);
+  const uint64_t span    =
+    offset - aligned + len;
+
+  // Slide the window forward if nobody is reading from it
+  if (window.leases == 0 && span <= WindowSize)
+  {
+    if (window.view != nullptr)
+      UnmapViewOfFile (window.view);
+
+    window.begin = aligned;
+    window.size  = static_cast <size_t> (std::min <uint64_t> (WindowSize, _size - aligned));
+    window.view  =
+      static_cast <BYTE *> (
+        MapViewOfFile (_hMapping, FILE_MAP_READ, static_cast <DWORD> (aligned >> 32),
+                                                 static_cast <DWORD> (aligned & 0xFFFFFFFF), window.size)
+      );
+
+    if (window.view == nullptr)
+    {
+      PLOG_ERROR << "Failed to map appinfo.vdf window at " << aligned << ", error: " << GetLastError ( );
+
+      window.size = 0;
+
+      return nullptr;
+    }
+
+    window.leases++;
+
+    return window.view + (offset - aligned);
+  }
+
+  // Otherwise map just the requested range until it is released
+  BYTE* pBase =
+    static_cast <BYTE *> (
+      MapViewOfFile (_hMapping, FILE_MAP_READ, static_cast <DWORD> (aligned >> 32),
+                                               static_cast <DWORD> (aligned & 0xFFFFFFFF), static_cast <SIZE_T> (span))
+    );
+
+  if (pBase == nullptr)
+  {
+    PLOG_ERROR << "Failed to map appinfo.vdf range at " << offset << ", error: " << GetLastError ( );
+
+    return nullptr;
+  }
+
+  window.temp_views.emplace_back (pBase + (offset - aligned), pBase);
+
+  return pBase + (offset - aligned);
+}
+
+void
+skValveDataFile::_releaseView (BYTE* pView)
+{
+  if (_mem != nullptr || _window == nullptr || pView == nullptr)
+    return;
+
+  auto& window = *_window;
+
+  std::lock_guard <std::mutex> lock (window.mutex);
+
+  if (pView >= window.view && pView < window.view + window.size)
+  {
+    if (window.leases > 0)
+        window.leases--;
+
+    return;
+  }
+
+  for (auto it  = window.temp_views.begin ();
+            it != window.temp_views.end   (); ++it)
+  {
+    if (it->first == pView)
+    {
+      UnmapViewOfFile (it->second);
+
+      window.temp_views.erase (it);
+
+      break;
+    }
+  }
+}
+
+void
+app_section_s::tape_s::clear (void)
+{
+  op    .clear ();
+  path  .clear ();
+  key   .clear ();
+  depth .clear ();
+  parent.clear ();
+  end   .clear ();
+  name  .clear ();
+  value .clear ();
+  open  .clear ();
+}
+
+uint32_t
+app_section_s::tape_s::push (_TokenOp token, _PathId id, uint32_t parent_row, _KeyId key_id, const char* key_name, void* val)
+{
+  const uint32_t row =
+    static_cast <uint32_t> (op.size ());
+
+  op    .push_back (static_cast <uint8_t> (token));
+  path  .push_back (id);
+  key   .push_back (key_id);
+  depth .push_back (static_cast <uint16_t> (open.size ()));
+  parent.push_back (parent_row);
+  end   .push_back (_NoParent);
+  name  .push_back (key_name);
+  value .push_back (val);
+
+  return row;
+}
+
+// Must match the order of app_section_s::_KeyId
+static constexpr const char* SKIF_VDF_KeyNames [] = {
+  "",
+  "appinfo", "common", "extended", "config", "launch", "ufs", "depots", "branches",
+  "library_assets_full", "library_capsule", "image", "rootoverrides", "savefiles", "platforms",
+  "osarch", "type", "icon", "english", "vacmodulefilename",
+  "oslist", "betakey", "executable", "arguments", "description", "workingdir", "ownsdlc",
+  "os", "root", "useinstead", "addpath", "path", "hidecloudui",
+  "buildid", "pwdrequired", "timeupdated"
+};
+
+static_assert ( std::size (SKIF_VDF_KeyNames) ==
+                  static_cast <size_t> (app_section_s::_KeyId::_Count) );
+
+// Case-insensitive FNV-1a
+static uint32_t
+SKIF_VDF_HashKey (const char* name, uint32_t seed)
+{
+  uint32_t hash = 2166136261u ^ seed;
+
+  for ( ; *name != '\0' ; ++name )
+  {
+    char ch = *name;
+
+    if (ch >= 'A' && ch <= 'Z')
+        ch += ('a' - 'A');
+
+    hash = (hash ^ static_cast <uint8_t> (ch)) * 16777619u;
+  }
+
+  return hash;
+}
+
+// Perfect hash over SKIF_VDF_KeyNames; the seed is searched for once at
+//   startup so that every known name lands in a slot of its own
+struct SKIF_VDF_KeyTable {
+  static constexpr uint32_t _Slots = 256;
+
+  uint32_t                   seed = 0;
+  app_section_s::_KeyId      slots [_Slots] = { };
+
+  SKIF_VDF_KeyTable (void)
+  {
+    for ( seed = 0 ; seed < UINT16_MAX ; seed++ )
+    {
+      std::fill (std::begin (slots), std::end (slots), app_section_s::_KeyId::Unknown);
+
+      bool collision = false;
+
+      for ( size_t id = 1 ; id < std::size (SKIF_VDF_KeyNames) && ! collision ; id++ )
+      {
+        auto& slot =
+          slots [SKIF_VDF_HashKey (SKIF_VDF_KeyNames [id], seed) % _Slots];
+
+        if (slot != app_section_s::_KeyId::Unknown)
+          collision = true;
+        else
+          slot = static_cast <app_section_s::_KeyId> (id);
+      }
+
+      if (! collision)
+        break;
+    }
+  }
+};
+
+app_section_s::_KeyId
+app_section_s::lookupKey (const char* name)
+{
+  static const SKIF_VDF_KeyTable table;
+
+  if (name == nullptr)
+    return _KeyId::Unknown;
+
+  const _KeyId id =
+    table.slots [SKIF_VDF_HashKey (name, table.seed) % SKIF_VDF_KeyTable::_Slots];
+
+  // Unknown names can still hash to an occupied slot, so confirm the match
+  if (id != _KeyId::Unknown && _stricmp (name, SKIF_VDF_KeyNames [static_cast <size_t> (id)]) != 0)
+    return _KeyId::Unknown;
+
+  return id;
+}
+
+// Maps a section to its path id based on the path id of its parent
+static app_section_s::_PathId
+SKIF_VDF_ClassifySection (app_section_s::_PathId parent, app_section_s::_KeyId key)
+{
+  using _PathId = app_section_s::_PathId;
+  using _KeyId  = app_section_s::_KeyId;
+
+  switch (parent)
+  {
+    case _PathId::Ignored:
+      return _PathId::Ignored;
+
+    case _PathId::AppInfo:
+      switch (key)
+      {
+        case _KeyId::common:              return _PathId::Common;
+        case _KeyId::extended:            return _PathId::Extended;
+        case _KeyId::config:              return _PathId::Config;
+        case _KeyId::ufs:                 return _PathId::UFS;
+        case _KeyId::depots:              return _PathId::Depots;
+        default:                          return _PathId::Ignored;
+      }
+
+    case _PathId::Common:
+      return (key == _KeyId::library_assets_full) ? _PathId::CommonLibraryAssets
+                                                  : _PathId::Common;
+
+    case _PathId::CommonLibraryAssets:
+      return (key == _KeyId::library_capsule)     ? _PathId::CommonLibraryCapsule
+                                                  : _PathId::Common;
+
+    case _PathId::CommonLibraryCapsule:
+      return (key == _KeyId::image)               ? _PathId::CommonLibraryCapsuleImage
+                                                  : _PathId::Common;
+
+    case _PathId::CommonLibraryCapsuleImage:
+      return _PathId::Common;
+
+    case _PathId::Extended:
+      return _PathId::Extended;
+
+    case _PathId::Config:
+      return (key == _KeyId::launch)              ? _PathId::ConfigLaunch
+                                                  : _PathId::Ignored;
+
+    // Launch options nest their oslist/osarch/betakey in a config child
+    case _PathId::ConfigLaunch:
+    case _PathId::LaunchEntry:
+      return _PathId::LaunchEntry;
+
+    case _PathId::UFS:
+      switch (key)
+      {
+        case _KeyId::rootoverrides:       return _PathId::RootOverrides;
+        case _KeyId::savefiles:           return _PathId::SaveFiles;
+        default:                          return _PathId::Ignored;
+      }
+
+    case _PathId::RootOverrides:
+    case _PathId::RootOverride:
+      return _PathId::RootOverride;
+
+    case _PathId::SaveFiles:
+      return _PathId::SaveFile;
+
+    case _PathId::SaveFile:
+      return (key == _KeyId::platforms)           ? _PathId::SaveFilePlatforms
+                                                  : _PathId::Ignored;
+
+    case _PathId::Depots:
+      return (key == _KeyId::branches)            ? _PathId::Branches
+                                                  : _PathId::Ignored;
+
+    case _PathId::Branches:
+      return _PathId::Branch;
+
+    default:
+      return _PathId::Ignored;
+  }
+}
+
+void
+app_section_s::parse (section_desc_s& desc, const skValveDataFile& vdf)
+{
+  tape.clear ();
+
+  exception     = false;
+  bytes_skipped = 0;
+
+  // Nesting level inside a skipped subtree, and where that subtree began
+  uint32_t skip_depth = 0;
+  uint8_t* skip_start = nullptr;
+
+  uint8_t* const end =
+    (uint8_t *)desc.blob + desc.size;
+
+  // Operands are checked against the end of the blob, so truncated or malformed
+  //   data sets the exception flag rather than reading past the end of it
+  auto _HasBytes = [&](const uint8_t* pos, size_t len) -> bool
+  {
+    if (static_cast <size_t> (end - pos) >= len)
+      return true;
+
+    exception = true;
+
+    return false;
+  };
+
+  // Leaves cur on the null terminator of the string that starts past it
+  auto _SkipString = [&](uint8_t*& pos) -> bool
+  {
+            pos++;
+    while ( pos < end && *pos != '\0')
+          ++pos;
+
+    return _HasBytes (pos, 1);
+  };
+
+  {
+    for ( uint8_t *cur = (uint8_t *)desc.blob ;
+                   cur < end && ! exception   ;
+                   cur++ )
+    {
+      // A plain byte, as malformed data can hold values outside of _TokenOp
+      const uint8_t op =
+        *cur;
+
+      // Nothing in here is wanted, so only keep track of nesting and operand sizes
+      //   until the matching SectionEnd; no names are resolved and no rows are added
+      if (skip_depth > 0)
+      {
+        if (op == SectionEnd)
+        {
+          if (--skip_depth == 0)
+            bytes_skipped += (cur - skip_start);
+
+          continue;
+        }
+
+        if (vdf.vdf_version >= 0x29)
+        {
+          if (! _HasBytes (cur + 1, sizeof (uint32_t)))
+            break;
+
+          cur += 4;
+        }
+
+        else if (! _SkipString (cur))
+          break;
+
+        switch (op)
+        {
+          case SectionBegin:
+            ++skip_depth;
+            break;
+
+          case String:
+            _SkipString (cur);
+            break;
+
+          case Int32:
+            if (_HasBytes (cur + 1, sizeof (int32_t)))
+              cur += sizeof (int32_t);
+            break;
+
+          case Int64:
+            if (_HasBytes (cur + 1, sizeof (int64_t)))
+              cur += sizeof (int64_t);
+            break;
+
+          default:
+            PLOG_WARNING << "Unknown VDF Token Operator: " << (int)op;
+            exception = true;
+            break;
+        }
+
+        continue;
+      }
+
+      auto name =
+        (char *)(cur + 1);
+
+      auto key =
+        _KeyId::Unknown;
+
+      if (op != SectionEnd)
+      {
+        // String Table Lookup (June 2024+)
+        //
+        if (vdf.vdf_version >= 0x29)
+        {
+          if (vdf.table == nullptr || ! _HasBytes (cur + 1, sizeof (uint32_t)))
+          {
+            exception = true;
+            break;
+          }
+
+          name =
+            (char *)vdf.table->strings;
+
+          const auto str_idx =
+            *(uint32_t *)(cur + 1);
+
+#ifdef DEBUG
+          PLOG_VERBOSE << "String Table Index:  " << str_idx << ", op=" << (int)op;
+#endif
+
+          if ( str_idx < vdf.strs.size () )
+          {
+            name =
+              vdf.strs     [str_idx];
+            key  =
+              vdf.str_keys [str_idx];
+#ifdef DEBUG
+            PLOG_VERBOSE << "String=" << name;
+#endif
+          }
+
+          else
+            PLOG_ERROR << "String Table Index (" << str_idx << ") Out-of-Range!";
+
+          cur += 4;
+        }
+
+        // Legacy: null-terminated name is serialized inline after token type
+        //
+        else
+        {
+          // Skip past name declarations, except for </Section> because it has no name.
+          if (! _SkipString (cur))
+            break;
+
+          key =
+            lookupKey (name);
+        }
+      }
+
+      const uint32_t parent_row =
+        tape.open.empty () ? _NoParent
+                           : tape.open.back ();
+
+      const _PathId parent_path =
+        (parent_row == _NoParent) ? Ignored
+                                  : (_PathId)tape.path [parent_row];
+
+      if (op == SectionBegin)
+      {
+        const _PathId path =
+          (parent_row == _NoParent) ? (key == _KeyId::appinfo ? AppInfo : Ignored)
+                                    : SKIF_VDF_ClassifySection (parent_path, key);
+
+        if (selective && path == Ignored)
+        {
+          skip_depth = 1;
+          skip_start = cur;
+
+          continue;
+        }
+
+        tape.open.push_back (
+          tape.push (SectionBegin, path, parent_row, key, name, (void *)cur)
+        );
+      }
+
+      else if (op == SectionEnd)
+      {
+        if (parent_row != _NoParent)
+        {
+          tape.open.pop_back ();
+
+          tape.end [parent_row] =
+            tape.push (SectionEnd, parent_path, parent_row, _KeyId::Unknown, nullptr, (void *)cur);
+        }
+      }
+
+      else
+      {
+        // Only values that lie entirely within the blob make it onto the tape
+        uint8_t* value = cur + 1;
+
+        switch (op)
+        {
+          case String:
+            if (! _SkipString (cur))
+              break;
+            if (parent_row != _NoParent)
+              tape.push ((_TokenOp)op, parent_path, parent_row, key, name, (void *)value);
+            else
+              exception = true;
+            break;
+
+          case Int32:
+          case Int64:
+            if (! _HasBytes (value, (op == Int32) ? sizeof (int32_t)
+                                                  : sizeof (int64_t)))
+              break;
+            if (parent_row != _NoParent)
+              tape.push ((_TokenOp)op, parent_path, parent_row, key, name, (void *)value);
+            else
+              exception = true;
+            cur += ((op == Int32) ? sizeof (int32_t)
+                                  : sizeof (int64_t));
+            break;
+
+          default:
+            PLOG_WARNING << "Unknown VDF Token Operator: " << (int)op;
+            exception = true;
+            break;
+        }
+      }
+    }
+  }
+}
+
+void
+app_section_s::keysOf (uint32_t row, std::vector <key_s>& keys) const
+{
+  keys.clear ();
+
+  const uint32_t end_row =
+    tape.end [row];
+
+  if (end_row == _NoParent)
+    return;
+
+  for ( uint32_t cur = row + 1 ; cur < end_row ; )
+  {
+    if (tape.op [cur] == SectionBegin)
+    {
+      cur = tape.end [cur] + 1;
+      continue;
+    }
+
+    keys.push_back ({ tape.key [cur], tape.name [cur], (_TokenOp)tape.op [cur], tape.value [cur] });
+
+    cur++;
+  }
+}
+
+uint32_t
+app_section_s::entryOf (uint32_t row, _PathId container) const
+{
+  while (row != _NoParent)
+  {
+    const uint32_t parent_row =
+      tape.parent [row];
+
+    if (parent_row == _NoParent)
+      break;
+
+    if (tape.path [parent_row] == container)
+      return row;
+
+    row = parent_row;
+  }
+
+  return _NoParent;
+}
+
+void*
+appinfo_s::getRootSection (size_t* pSize)
+{
+  size_t vdf_header_size =
+    ( vdf_version > 0x27 ? sizeof (appinfo_s)
+                         : sizeof (appinfo27_s) );
+
+  size_t kv_size =
+    (size - vdf_header_size + 8);
+
+  if (pSize != nullptr)
+     *pSize  = kv_size;
+
+  return
+    (uint8_t*)&appid + vdf_header_size;
+}
+
+appinfo_s*
+appinfo_s::getNextApp (void)
+{
+  section_desc_s root_sec{};
+
+  root_sec.blob =
+    getRootSection (&root_sec.size);
+
+  auto *pNext =
+    (appinfo_s *)(
+      (uint8_t *)root_sec.blob +
+                 root_sec.size);
+
+  return
+    ( pNext->appid == _LastSteamApp ) ?
+                              nullptr : pNext;
+}
+
+void
+skValveDataFile::_buildIndex (void)
+{
+  index.clear ();
+
+  if (_root_ofs == 0)
+    return;
+
+  // A single pass over the file, only the fixed-size headers are touched
+  for ( uint64_t offset  = _root_ofs ;
+                 offset  < _size ; )
+  {
+    const size_t len =
+      static_cast <size_t> (std::min <uint64_t> (sizeof (appinfo27_s), _size - offset));
+
+    auto pIter =
+      reinterpret_cast <appinfo27_s *> (_acquireView (offset, len));
+
+    if (pIter == nullptr)
+      break;
+
+    if (len >= sizeof (appinfo27_s::appid) && pIter->appid == _LastSteamApp)
+    {
+      _releaseView ((BYTE *)pIter);
+      break;
+    }
+
+    if (len < sizeof (appinfo27_s))
+    {
+      PLOG_ERROR << "appinfo.vdf ended unexpectedly while indexing!";
+      _releaseView ((BYTE *)pIter);
+      break;
+    }
+
+    const uint64_t next =
+      offset + sizeof (appinfo27_s::appid)
+             + sizeof (appinfo27_s::size) + pIter->size;
+
+    if (next > _size)
+    {
+      PLOG_ERROR << "appinfo.vdf entry for " << pIter->appid << " is truncated!";
+      _releaseView ((BYTE *)pIter);
+      break;
+    }
+
+    uint64_t                   sha1 = 0;
+    memcpy (&sha1, pIter->sha1sum, sizeof (sha1));
+
+    index.push_back ({
+      pIter->appid,
+      pIter->change_num,
+      pIter->size,
+      offset,
+      sha1
+    });
+
+    _releaseView ((BYTE *)pIter);
+
+    offset = next;
+  }
+
+  std::sort ( index.begin (), index.end (),
+    [](const app_index_s& lhs, const app_index_s& rhs)
+    {
+      return lhs.appid < rhs.appid;
+    }
+  );
+
+  PLOG_VERBOSE << "Indexed " << index.size () << " apps in appinfo.vdf";
+}
+
+const skValveDataFile::app_index_s*
+skValveDataFile::findApp (AppId_t appid)
+{
+  auto it =
+    std::lower_bound ( index.cbegin (), index.cend (), appid,
+      [](const app_index_s& entry, AppId_t id)
+      {
+        return entry.appid < id;
+      }
+    );
+
+  if (it == index.cend () || it->appid != appid)
+    return nullptr;
+
+  return &(*it);
+}
@@ -464,11 +464,8 @@ SKIF_Xbox_GetInstalledAppIDs (std::vector <std::pair < std::string, app_record_s
                       record.specialk.profile_dir      = trimmed;
                       record.specialk.profile_dir_utf8 = SK_WideCharToUTF8(record.specialk.profile_dir);
 
-                      std::pair <std::string, app_record_s>
-                        Xbox (record.names.normal, record);
-
                       //PLOG_VERBOSE << "Added to the list of detected games!";
-                      apps->emplace_back (Xbox);
+                      apps->emplace_back (record.names.normal, std::move (record));
                     }
                   }
                 }
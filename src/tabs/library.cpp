@@ -153,8 +153,19 @@ std::vector <
 std::set    < std::string >
               g_apptickets;
 
+SKIF_AppRegistry
+              g_appRegistry (&g_apps);
+
+SKIF_AppListView
+              g_appList     (&g_apps);
+
 nlohmann::json jsonMetaDB;
 
+// g_apps holds the library snapshot of the last session. The library worker read db.json
+//   before any edits made to it, so edited apps are noted and carried over on the swap.
+static bool                         snapshotShown = false;
+static std::vector <SKIF_AppHandle> snapshotEdits;
+
 const float fTintMin     = 0.75f;
       float fTint        = 1.0f;
       float fAlpha       = 0.0f;
@@ -232,16 +243,6 @@ AdjustAlpha (float a)
   return std::pow (a, 1.0f / 2.2f );
 }
 
-static std::string
-GetEffectiveCategory (app_record_s* app)
-{
-  return (    app->skif.pinned > 0 || (app->skif.pinned == -1 && app->steam.shared.favorite == 1))
-         ?   "Favorites"
-         : (! app->skif.category.empty())
-         ?    app->skif.category
-         :   "Games";
-}
-
 // This is shared between the Icon menu and the Filter menu
 static void
 ShowLargeIconToggle (void)
@@ -480,7 +481,7 @@ SearchAppsList (void)
           result.text     = app.second.names.normal;
           result.store    = app.second.store;
           result.app_id   = app.second.id;
-          result.category = GetEffectiveCategory (&app.second);
+          result.category = SKIF_AppList_GetEffectiveCategory (&app.second);
           result.pos      = app.second.names.pre_stripped;
           result.len      = strlen (test_);
 
@@ -607,6 +608,9 @@ JsonDB_WriteFile (void)
 bool
 JsonDB_UpdateApp (app_record_s* pApp, bool bWriteToDisk)
 {
+  if (snapshotShown)
+    snapshotEdits.push_back (SKIF_AppRegistry::handleOf (pApp));
+
   // Update the db.json file with any new values
   if (! jsonMetaDB.is_discarded())
   {
@@ -2350,7 +2354,7 @@ DrawGameContextMenu (app_record_s* pApp)
 
         JsonDB_UpdateApp  ( pApp, true);
 
-        SKIF_GamingCollection::SortApps (&g_apps);
+        SKIF_GamingCollection::RepositionApp (&g_apps, pApp);
         sort_changed = true;
       }
     }
@@ -2368,7 +2372,7 @@ DrawGameContextMenu (app_record_s* pApp)
 
       JsonDB_UpdateApp   (pApp, true);
 
-      SKIF_GamingCollection::SortApps (&g_apps);
+      SKIF_GamingCollection::RepositionApp (&g_apps, pApp);
       sort_changed = true;
     }
 
@@ -2390,7 +2394,7 @@ DrawGameContextMenu (app_record_s* pApp)
         pApp->skif.pinned = isFavorite ? 0 : 1;
         JsonDB_UpdateApp (pApp, true);
 
-        SKIF_GamingCollection::SortApps (&g_apps);
+        SKIF_GamingCollection::RepositionApp (&g_apps, pApp);
         sort_changed = true;
       }
 
@@ -2501,7 +2505,7 @@ DrawGameContextMenu (app_record_s* pApp)
         pApp->skif.category = newCategoryName;
         JsonDB_UpdateApp (pApp, true);
 
-        SKIF_GamingCollection::SortApps (&g_apps);
+        SKIF_GamingCollection::RepositionApp (&g_apps, pApp);
         //sort_changed = true; // Disabled as this causes a noticable flicker on the menu when the game goes out and in of visibility
       }
 
@@ -2550,7 +2554,7 @@ DrawGameContextMenu (app_record_s* pApp)
 
         JsonDB_UpdateApp (pApp, true);
 
-        SKIF_GamingCollection::SortApps (&g_apps);
+        SKIF_GamingCollection::RepositionApp (&g_apps, pApp);
         sort_changed = true;
       }
 
@@ -3205,7 +3209,7 @@ DrawSpecialKContextMenu (app_record_s* pApp)
 
     JsonDB_UpdateApp  ( pApp, true);
 
-    SKIF_GamingCollection::SortApps (&g_apps);
+    SKIF_GamingCollection::RepositionApp (&g_apps, pApp);
     sort_changed = true;
   }
 }
@@ -4720,10 +4724,7 @@ SKIF_UI_Tab_DrawLibrary (void)
     SKIF_record.specialk.profile_dir      = SK_FormatStringW(LR"(%ws\Profiles)", _path_cache.specialk_userdata);
     SKIF_record.specialk.profile_dir_utf8 = SK_WideCharToUTF8 (SKIF_record.specialk.profile_dir);
 
-    std::pair <std::string, app_record_s>
-      SKIF ( "Special K", SKIF_record );
-
-    g_apps.emplace_back (SKIF);
+    g_apps.emplace_back ("Special K", std::move (SKIF_record));
   }
 #endif
 
@@ -4849,12 +4850,230 @@ SKIF_UI_Tab_DrawLibrary (void)
 
   static lib_worker_thread_s* library_worker = nullptr;
 
+  // Swaps a populated list of apps into g_apps and prepares it for the UI
+  auto _SwapInLibrary = [&](lib_worker_thread_s* data, bool reconcile)
+  {
+    struct IconCache {
+      app_record_s::tex_registry_s tex_icon;
+      app_record_s::Store store;
+      AppId_t id;
+    };
+
+    std::vector<IconCache> icon_cache;
+
+    // A batch in flight was started on the records that are about to be replaced
+    if (appinfo != nullptr)
+      appinfo->cancelProcessing ( );
+
+    // The new list starts out unprocessed, so let processing pick it up again
+    steamFallback = false;
+
+    // Clear up any unacknowledged icon workers
+    for (auto& app : g_apps)
+    {
+      if (app.second.tex_icon.iWorker == 1)
+      {
+        if (WaitForSingleObject (app.second.tex_icon.hWorker, 200) == WAIT_OBJECT_0) // 200 second timeout (maybe change it?)
+        {
+          CloseHandle (app.second.tex_icon.hWorker);
+          app.second.tex_icon.hWorker = NULL;
+          app.second.tex_icon.iWorker = 2;
+          activeIconWorkers--;
+        }
+      }
+      
+      // Cache any existing icon textures...
+      if (app.second.tex_icon.texture.p != nullptr)
+      {
+        icon_cache.push_back ({
+          app.second.tex_icon,
+          app.second.store,
+          app.second.id
+        });
+
+        //SKIF_ResourcesToFree.push(app.second.tex_icon.texture.p);
+        //app.second.tex_icon.texture.p = nullptr;
+      }
+    }
+
+    // Clear current data
+    labels         = { };
+    labelsFiltered = { };
+
+    // Insert new data, the previous list ends up in data and is released along with it
+    g_apps      .swap (data->apps);
+    g_apptickets.swap (data->apptickets);
+    labels       = std::move (data->labels);
+
+    g_appRegistry.invalidate ( );
+    g_appList    .invalidate ( );
+
+    // Move cached icons over
+    for (auto& app : g_apps)
+    {
+      for (auto& icon : icon_cache)
+      {
+        if (icon.id    == app.second.id
+         && icon.store == app.second.store)
+        {
+          app.second.tex_icon = icon.tex_icon; // Move it over
+          app.second.tex_icon.iWorker = 2;
+          icon.id = 0; // Mark it _not_ for release
+          break;
+        }
+      }
+    }
+
+    // Push unused icons for release
+    for (auto& icon : icon_cache)
+    {
+      if (icon.id == 0)
+        continue; // Skip icons marked as 0
+      
+      SKIF_ResourcesToFree.push(icon.tex_icon.texture.p);
+      icon.tex_icon.texture.p = nullptr;
+    }
+
+    bool resortGames   = false;
+
+    // Move edits made to the snapshot over (favorites, categories, properties, launches)
+    if (reconcile)
+    {
+      SKIF_AppRegistry previous (&data->apps);
+
+      for (auto& handle : snapshotEdits)
+      {
+        app_record_s* pEdited = previous     .find (handle);
+        app_record_s* pApp    = g_appRegistry.find (handle);
+
+        if (pEdited != nullptr && pApp != nullptr)
+        {
+          pApp->skif  = pEdited->skif;
+          resortGames = true;
+        }
+      }
+    }
+
+    snapshotEdits.clear ();
+
+    // Do not fade in the list again when it only replaces the snapshot of the last session
+    if (! reconcile)
+      fAlphaList = (_registry.bFadeCovers) ? 0.0f : 1.0f;
+
+    frameLibraryRefreshed = ImGui::GetFrameCount ( );
+
+    // Reset selection to Special K, but only if set to something else than -1
+    if (selection.appid != 0)
+      selection.reset();
+
+    int tmpPinnedOnTop = 0;
+
+    // Do other misc stuff
+    for (auto& app : g_apps)
+    {
+      if (app.second.id == 0)
+        continue;
+
+      // Set to last selected if it can be found
+      if (app.second.id       ==                      _registry.uiLastSelectedGame &&
+          app.second.store    == (app_record_s::Store)_registry.uiLastSelectedStore)
+      {
+        PLOG_VERBOSE << "Selected app ID " << app.second.id << " from platform ID " << (int)app.second.store << ".";
+        selection.appid        =    app.second.id;
+        selection.store        =    app.second.store;
+        selection.category     =   (app.second.skif.pinned > 50 && ! _registry._LibHorizonMode && _registry._LibPinnedVisible) // Only when not using horizon mode
+                               ?   "Favorites (pinned)" // Workaround to not expand Favorites tab on launch
+                               :    SKIF_AppList_GetEffectiveCategory (&app.second);
+        search_selection.id    =    selection.appid;
+        search_selection.store =    selection.store;
+        search_selection.category = selection.category;
+        update = true;
+      }
+
+      // Prefill all apps with the current version (solves a single frame flicker the first time a game is selected)
+      app.second.specialk.injection.dll.version      = _inject.SKVer32;
+      app.second.specialk.injection.dll.version_utf8 = SK_WideCharToUTF8 (app.second.specialk.injection.dll.version);
+
+      // Apply the current filter
+      app.second.filtered = (charFilter[0] != '\0' && (StrStrIA (app.first.c_str(), charFilter) == NULL &&                // Name
+                                                       StrStrIA (app.second.skif.category.c_str(), charFilter) == NULL)); // Category
+
+      // Count the number of pinned entries on top
+      if (app.second.skif.pinned > 50)
+      {
+        // Only allow 5 pinned on top
+        if (5 > tmpPinnedOnTop)
+          tmpPinnedOnTop++;
+
+        // Reduce all other to normal favorite status
+        else
+        {
+          app.second.skif.pinned = 50;
+          resortGames = true;
+        }
+      }
+    }
+
+    if (resortGames)
+    {
+      SKIF_GamingCollection::SortApps (&g_apps);
+      sort_changed = true;
+    }
+
+    // Use a separate pass to count the actual figures used for the UI calculations later
+    numRegular       = 0;
+    numPinnedOnTop   = 0;
+
+    for (auto& app : g_apps)
+    {
+      if (app.second.id == 0 || app.second.filtered)
+        continue;
+
+      InsertTrieKey (&app, &labelsFiltered);
+
+      numRegular++;
+
+      if (app.second.skif.pinned > 50)
+        numPinnedOnTop++;
+    }
+
+    numRegular -= numPinnedOnTop;
+  };
+
+  // Show the library of the last session right away, the worker started below
+  //   then repopulates it in the background and replaces it once it is done
+  static bool snapshotChecked = false;
+
+  if (! snapshotChecked && library_worker == nullptr)
+  {
+    snapshotChecked = true;
+
+    lib_worker_thread_s snapshot;
+
+    if (g_apps.empty ( ) && ! _registry._LibraryHidden &&
+        SKIF_GamingCollection::LoadSnapshot (&snapshot.apps, &snapshot.apptickets))
+    {
+      for (auto& app : snapshot.apps)
+      {
+        if (app.second.id != SKIF_STEAM_APPID || app.second.store != app_record_s::Store::Steam)
+          InsertTrieKey (&app, &snapshot.labels);
+      }
+
+      _SwapInLibrary (&snapshot, false);
+
+      snapshotShown = true;
+      sort_changed  = true;
+    }
+  }
+
   if (! PopulatedGames && library_worker == nullptr)
   {
     PLOG_INFO << "Populating library list...";
 
     // Initialize/reset the Steam appinfo.vdf Reader
-    appinfo = std::make_unique <skValveDataFile>(std::wstring(_path_cache.steam_install) + LR"(\appcache\appinfo.vdf)");
+    appinfo = std::make_unique <skValveDataFile>(std::wstring(_path_cache.steam_install) + LR"(\appcache\appinfo.vdf)",
+                                                   _registry.bSteamAppInfoWindowed ? skValveDataFile::LoadMode::Windowed
+                                                                                   : skValveDataFile::DefaultMode);
 
     library_worker = new lib_worker_thread_s;
     library_worker->steam_user = SKIF_Steam_GetCurrentUser ( );
@@ -4921,10 +5140,7 @@ SKIF_UI_Tab_DrawLibrary (void)
         SKIF_record.specialk.profile_dir      = SK_FormatStringW(LR"(%ws\Profiles)", _path_cache.specialk_userdata);
         SKIF_record.specialk.profile_dir_utf8 = SK_WideCharToUTF8 (SKIF_record.specialk.profile_dir);
 
-        std::pair <std::string, app_record_s>
-          SKIF ( "Special K", SKIF_record );
-
-        _data->apps.emplace_back (SKIF);
+        _data->apps.emplace_back ("Special K", std::move (SKIF_record));
         games = _data->apps.size();
       }
 
@@ -5420,6 +5636,9 @@ SKIF_UI_Tab_DrawLibrary (void)
 
       //PLOG_INFO << "Apps were sorted!";
 
+      if (! _registry._LibraryHidden)
+        SKIF_GamingCollection::SaveSnapshot (&_data->apps, &_data->apptickets);
+
       PLOG_INFO << "Finished populating the library list.";
 
       PLOG_INFO_IF(pPatTexSRV.p == nullptr) << "Loading the embedded Patreon texture...";
@@ -5459,161 +5678,9 @@ SKIF_UI_Tab_DrawLibrary (void)
 
   else if (! PopulatedGames && library_worker != nullptr && library_worker->iWorker == 1 && WaitForSingleObject (library_worker->hWorker, 0) == WAIT_OBJECT_0)
   {
+    _SwapInLibrary (library_worker, snapshotShown);
 
-    struct IconCache {
-      app_record_s::tex_registry_s tex_icon;
-      app_record_s::Store store;
-      AppId_t id;
-    };
-
-    std::vector<IconCache> icon_cache;
-
-    // Clear up any unacknowledged icon workers
-    for (auto& app : g_apps)
-    {
-      if (app.second.tex_icon.iWorker == 1)
-      {
-        if (WaitForSingleObject (app.second.tex_icon.hWorker, 200) == WAIT_OBJECT_0) // 200 second timeout (maybe change it?)
-        {
-          CloseHandle (app.second.tex_icon.hWorker);
-          app.second.tex_icon.hWorker = NULL;
-          app.second.tex_icon.iWorker = 2;
-          activeIconWorkers--;
-        }
-      }
-      
-      // Cache any existing icon textures...
-      if (app.second.tex_icon.texture.p != nullptr)
-      {
-        icon_cache.push_back ({
-          app.second.tex_icon,
-          app.second.store,
-          app.second.id
-        });
-
-        //SKIF_ResourcesToFree.push(app.second.tex_icon.texture.p);
-        //app.second.tex_icon.texture.p = nullptr;
-      }
-    }
-
-    // Clear current data
-    g_apps         = { };
-    g_apptickets   = { };
-    labels         = { };
-    labelsFiltered = { };
-
-    // Insert new data
-    g_apps       = library_worker->apps;
-    g_apptickets = library_worker->apptickets;
-    labels       = library_worker->labels;
-
-    // Move cached icons over
-    for (auto& app : g_apps)
-    {
-      for (auto& icon : icon_cache)
-      {
-        if (icon.id    == app.second.id
-         && icon.store == app.second.store)
-        {
-          app.second.tex_icon = icon.tex_icon; // Move it over
-          app.second.tex_icon.iWorker = 2;
-          icon.id = 0; // Mark it _not_ for release
-          break;
-        }
-      }
-    }
-
-    // Push unused icons for release
-    for (auto& icon : icon_cache)
-    {
-      if (icon.id == 0)
-        continue; // Skip icons marked as 0
-      
-      SKIF_ResourcesToFree.push(icon.tex_icon.texture.p);
-      icon.tex_icon.texture.p = nullptr;
-    }
-
-    fAlphaList = (_registry.bFadeCovers) ? 0.0f : 1.0f;
-
-    frameLibraryRefreshed = ImGui::GetFrameCount ( );
-
-    // Reset selection to Special K, but only if set to something else than -1
-    if (selection.appid != 0)
-      selection.reset();
-
-    bool resortGames   = false;
-    int tmpPinnedOnTop = 0;
-
-    // Do other misc stuff
-    for (auto& app : g_apps)
-    {
-      if (app.second.id == 0)
-        continue;
-
-      // Set to last selected if it can be found
-      if (app.second.id       ==                      _registry.uiLastSelectedGame &&
-          app.second.store    == (app_record_s::Store)_registry.uiLastSelectedStore)
-      {
-        PLOG_VERBOSE << "Selected app ID " << app.second.id << " from platform ID " << (int)app.second.store << ".";
-        selection.appid        =    app.second.id;
-        selection.store        =    app.second.store;
-        selection.category     =   (app.second.skif.pinned > 50 && ! _registry._LibHorizonMode && _registry._LibPinnedVisible) // Only when not using horizon mode
-                               ?   "Favorites (pinned)" // Workaround to not expand Favorites tab on launch
-                               :    GetEffectiveCategory (&app.second);
-        search_selection.id    =    selection.appid;
-        search_selection.store =    selection.store;
-        search_selection.category = selection.category;
-        update = true;
-      }
-
-      // Prefill all apps with the current version (solves a single frame flicker the first time a game is selected)
-      app.second.specialk.injection.dll.version      = _inject.SKVer32;
-      app.second.specialk.injection.dll.version_utf8 = SK_WideCharToUTF8 (app.second.specialk.injection.dll.version);
-
-      // Apply the current filter
-      app.second.filtered = (charFilter[0] != '\0' && (StrStrIA (app.first.c_str(), charFilter) == NULL &&                // Name
-                                                       StrStrIA (app.second.skif.category.c_str(), charFilter) == NULL)); // Category
-
-      // Count the number of pinned entries on top
-      if (app.second.skif.pinned > 50)
-      {
-        // Only allow 5 pinned on top
-        if (5 > tmpPinnedOnTop)
-          tmpPinnedOnTop++;
-
-        // Reduce all other to normal favorite status
-        else
-        {
-          app.second.skif.pinned = 50;
-          resortGames = true;
-        }
-      }
-    }
-
-    if (resortGames)
-    {
-      SKIF_GamingCollection::SortApps (&g_apps);
-      sort_changed = true;
-    }
-
-    // Use a separate pass to count the actual figures used for the UI calculations later
-    numRegular       = 0;
-    numPinnedOnTop   = 0;
-
-    for (auto& app : g_apps)
-    {
-      if (app.second.id == 0 || app.second.filtered)
-        continue;
-
-      InsertTrieKey (&app, &labelsFiltered);
-
-      numRegular++;
-
-      if (app.second.skif.pinned > 50)
-        numPinnedOnTop++;
-    }
-
-    numRegular -= numPinnedOnTop;
+    snapshotShown = false;
 
     CloseHandle (library_worker->hWorker);
     library_worker->hWorker = NULL;
@@ -5641,9 +5708,7 @@ SKIF_UI_Tab_DrawLibrary (void)
 
   // Ensure pApp points to the current selected game
   // This should be the only place where pApp changes during the whole frame!
-  for (auto& app : g_apps)
-    if (app.second.id == selection.appid && app.second.store == selection.store)
-      pApp = &app.second;
+  pApp = g_appRegistry.find (selection.store, selection.appid);
 
   // Default to primary launch config
   launchConfig = (pApp != nullptr && ! pApp->launch_configs.empty()) ? &pApp->launch_configs.begin()->second : nullptr;
@@ -5682,36 +5747,35 @@ SKIF_UI_Tab_DrawLibrary (void)
 
       if (WaitForSingleObject (worker.hWorker, 0) == WAIT_OBJECT_0)
       {
-        for (auto& app : g_apps)
+        app_record_s* pWorkerApp =
+          g_appRegistry.find (SKIF_AppRegistry::handleOf (&worker.app));
+
+        if (pWorkerApp != nullptr)
         {
-          if (app.second.id    == worker.app.id &&
-              app.second.store == worker.app.store)
-          {
-            // Backup the texture data (in particular any active worker data)
-            app_record_s::tex_registry_s tex_icon  = app.second.tex_icon;
-            app_record_s::tex_registry_s tex_cover = app.second.tex_cover;
+          // Backup the texture data (in particular any active worker data)
+          app_record_s::tex_registry_s tex_icon  = pWorkerApp->tex_icon;
+          app_record_s::tex_registry_s tex_cover = pWorkerApp->tex_cover;
 
-            // Copy the results over
-            app.second = worker.app;
+          // Move the results over, the worker is reset below anyway
+          *pWorkerApp = std::move (worker.app);
 
-            // Restore the texture data (and worker data)
-            app.second.tex_icon  = tex_icon;
-            app.second.tex_cover = tex_cover;
+          // Restore the texture data (and worker data)
+          pWorkerApp->tex_icon  = tex_icon;
+          pWorkerApp->tex_cover = tex_cover;
 
-            app.second.loading = false;
+          pWorkerApp->loading = false;
 
-            int cpu_post = (int)pApp->specialk.injection.injection.bitness;
+          int cpu_post = (int)pApp->specialk.injection.injection.bitness;
 
-            // If the CPU has changed, we need to update the metadata as well,
-            //   but only if it differs from our cached value...
-            if (cpu_post != worker.cpu_pre &&
-                cpu_post != app.second.skif.cpu_type)
-            {
-              app.second.skif.cpu_type = cpu_post; // 0 = Common,  1 = x86, 2 = x64, 0xFFFF = Any
+          // If the CPU has changed, we need to update the metadata as well,
+          //   but only if it differs from our cached value...
+          if (cpu_post != worker.cpu_pre &&
+              cpu_post != pWorkerApp->skif.cpu_type)
+          {
+            pWorkerApp->skif.cpu_type = cpu_post; // 0 = Common,  1 = x86, 2 = x64, 0xFFFF = Any
 
-              // Update the db.json file with any new values
-              JsonDB_UpdateApp (pApp, true);
-            }
+            // Update the db.json file with any new values
+            JsonDB_UpdateApp (pApp, true);
           }
         }
 
@@ -5738,7 +5802,7 @@ SKIF_UI_Tab_DrawLibrary (void)
         // Parse appinfo data for the current game
         // This must be done from the main thread since it also manipulates the g_apps array
         if (! pApp->processed)
-          appinfo->getAppInfo ( pApp->id, &g_apps );
+          appinfo->getAppInfo ( pApp );
       }
 
       // Only run a worker if we're not dealing with Special K
@@ -5748,7 +5812,7 @@ SKIF_UI_Tab_DrawLibrary (void)
 
         // Make a copy of pApp that we will use to update all data
         SKIF_Lib_GameWorkerThread_s* worker = &aGameWorkers[availableWorker];
-        worker->app        = *pApp;
+        worker->app        = pApp->clone ( );
         worker->apptickets = g_apptickets;
         worker->cpu_pre    = (int)pApp->specialk.injection.injection.bitness;
 
@@ -6249,6 +6313,8 @@ SKIF_UI_Tab_DrawLibrary (void)
     }
 
     numRegular -= numPinnedOnTop;
+
+    g_appList.invalidate ( );
   }
 
   //PLOG_VERBOSE << "Numbers: " << numRegular << " (regular) -- " << numPinnedOnTop << " (on top)";
@@ -6285,6 +6351,8 @@ SKIF_UI_Tab_DrawLibrary (void)
       }
 
       numRegular -= numPinnedOnTop;
+
+      g_appList.invalidate ( );
     }
 
     ImGui::PopStyleColor ( );
@@ -6412,7 +6480,7 @@ SKIF_UI_Tab_DrawLibrary (void)
   if (g_apps.empty())
     ImGui::Selectable      ("Loading games...###GamesCurrentlyLoading", false, ImGuiSelectableFlags_Disabled);
 
-  std::string current_category = "";
+  int         current_category = -1;
   int         categories       = 0;
   int         pinned_top       = 0;
   bool        resetNumOnTop    = true;
@@ -6426,32 +6494,42 @@ SKIF_UI_Tab_DrawLibrary (void)
   bool categoryMenuOpened = false;
 
   // Populate the list of games with all recognized games
-  for (auto& app : g_apps)
+  //   The pass goes over the dense list view, and only rows that are drawn touch the full record
+  for (auto& entry : g_appList.entries ( ))
   {
     // ID = 0 is assigned to corrupted entries, do not list these.
-    if (app.second.id == 0)
+    if (entry.id == 0)
       continue;
 
     // Count the number of pinned entries separately from filtered entries
-    if (app.second.skif.pinned > 50)
+    if (entry.pinned > 50)
       resetNumOnTop = false;
 
     // Check if there is an icon worker pending that we need to acknowledge the results for...
     //   ... *before* we filter out the game and skips the whole rest of the loop for this one!
-    if (app.second.tex_icon.iWorker == 1 && WaitForSingleObject (app.second.tex_icon.hWorker, 0) == WAIT_OBJECT_0)
+    if (entry.icon_pending)
     {
-      CloseHandle (app.second.tex_icon.hWorker);
-      app.second.tex_icon.hWorker = NULL;
-      app.second.tex_icon.iWorker = 2;
-      activeIconWorkers--;
+      auto& tex_icon = entry.app->second.tex_icon;
+
+      if (tex_icon.iWorker != 1)
+        entry.icon_pending = false;
+
+      else if (WaitForSingleObject (tex_icon.hWorker, 0) == WAIT_OBJECT_0)
+      {
+        CloseHandle (tex_icon.hWorker);
+        tex_icon.hWorker   = NULL;
+        tex_icon.iWorker   = 2;
+        entry.icon_pending = false;
+        activeIconWorkers--;
+      }
     }
 
     // Skips those filtered out by an active search field entry
-    if (app.second.filtered)
+    if (entry.filtered)
       continue;
 
     // Separate always on top (>50) from regular pinned (1-50), but only in regular mode
-    if (app.second.skif.pinned > 50 && ! _registry._LibHorizonMode && _registry._LibPinnedVisible) //  // ! _registry._LibHorizonMode
+    if (entry.pinned > 50 && ! _registry._LibHorizonMode && _registry._LibPinnedVisible) //  // ! _registry._LibHorizonMode
       pinned_top++;
     else if (pinned_top > 0)
     {
@@ -6486,10 +6564,11 @@ SKIF_UI_Tab_DrawLibrary (void)
       static bool category_opened    = false;
 
       // All favorited games are grouped as such
-      std::string tmpCategory = GetEffectiveCategory (&app.second);
-
-      if (tmpCategory != current_category)
+      if (entry.category != current_category)
       {
+        const std::string& tmpCategory =
+          g_appList.category (entry.category);
+
         auto it = std::find_if(_registry.vecCategories.begin(), _registry.vecCategories.end(), [&](const SKIF_RegistrySettings::category_s& category) { return category.name == tmpCategory; });
 
         // Always expand a category if a filter is active or the selected game was changed
@@ -6578,13 +6657,15 @@ SKIF_UI_Tab_DrawLibrary (void)
           ImGui::EndPopup ( );
         }
 
-        current_category = tmpCategory;
+        current_category = entry.category;
         categories++;
       }
 
       if (categories > 0 && ! category_opened)
         continue;
     }
+
+    auto& app = *entry.app;
     
     bool selected = (selection.appid == app.second.id &&
                      selection.store == app.second.store);
@@ -6732,7 +6813,7 @@ SKIF_UI_Tab_DrawLibrary (void)
       selection.store              =    app.second.store;
       selection.category           = (  app.second.skif.pinned > 50)
                                    ?   "Favorites (pinned)" // Workaround to not expand Favorites tab on launch
-                                   :    GetEffectiveCategory (&app.second);
+                                   :    SKIF_AppList_GetEffectiveCategory (&app.second);
       selected                     =    true;
 
       // Only update the last selected value if we're not in hidden view
@@ -6799,7 +6880,7 @@ SKIF_UI_Tab_DrawLibrary (void)
         load_str = app.second.install_dir + L"\\goggame-" + std::to_wstring(app.second.id) + L".ico";
       else if (app.second.store  == app_record_s::Store::Steam)  // Steam
       {
-        appinfo->getAppInfo ( app.second.id, &g_apps );
+        appinfo->getAppInfo ( &app.second );
         load_str = SK_FormatStringW(LR"(%ws\appcache\librarycache\%i\%hs.jpg)", _path_cache.steam_install, app.second.id, app.second.common_config.icon_hash.c_str ()); //L"_icon.jpg"
       }
       else if (app.second.store  == app_record_s::Store::Xbox)  // Xbox
@@ -6853,6 +6934,7 @@ SKIF_UI_Tab_DrawLibrary (void)
         PLOG_VERBOSE << "An icon worker was spawned successfully!";
         app.second.tex_icon.hWorker = hWorkerThread;
         app.second.tex_icon.iWorker = 1;
+        entry.icon_pending          = true;
       }
 
       else // Someting went wrong during thread creation, so free up the memory we allocated earlier
@@ -7112,7 +7194,7 @@ SKIF_UI_Tab_DrawLibrary (void)
 #pragma endregion
 
   // Refresh running state of SKIF Custom, Epic, GOG, and Xbox titles
-  SKIF_GamingCollection::RefreshRunningApps (&g_apps);
+  SKIF_GamingCollection::RefreshRunningApps (&g_apps, &g_appRegistry);
 
 #pragma region ServiceMenu
 
@@ -7578,7 +7660,7 @@ SKIF_UI_Tab_DrawLibrary (void)
               ImVec2 dontCare;
 
               if (pApp->store == app_record_s::Store::Steam)
-                appinfo->getAppInfo ( pApp->id, &g_apps );
+                appinfo->getAppInfo ( pApp );
 
               // Reload the icon
               LoadLibraryTexture (LibraryTexture::Icon,
@@ -8713,7 +8795,7 @@ SKIF_UI_Tab_DrawLibrary (void)
 
       else if (resort)
       {
-        SKIF_GamingCollection::SortApps (&g_apps);
+        SKIF_GamingCollection::RepositionApp (&g_apps, pApp);
         sort_changed = true;
       }
 
@@ -8888,7 +8970,12 @@ SKIF_UI_Tab_DrawLibrary (void)
           for (auto& app : g_apps)
           {
             if (app.second.skif.category == static_category.Name)
+            {
               app.second.skif.category    = static_category.newName;
+
+              if (snapshotShown)
+                snapshotEdits.push_back (SKIF_AppRegistry::handleOf (&app.second));
+            }
           }
 
           SKIF_GamingCollection::SortApps (&g_apps);
@@ -9546,40 +9633,92 @@ SKIF_UI_Tab_DrawLibrary (void)
   
   if (_registry.bLibrarySteam)
   {
+    // Steam touches appinfo.vdf constantly (e.g. while downloading), so instead of repopulating
+    //   the library only the apps that were actually added or changed in it are reprocessed
+    if (appinfo != nullptr && PopulatedGames && library_worker == nullptr && SKIF_Steam_isAppInfoSignaled ( ))
+    {
+      auto refreshed =
+        std::make_unique <skValveDataFile> (std::wstring (_path_cache.steam_install) + LR"(\appcache\appinfo.vdf)",
+                                              _registry.bSteamAppInfoWindowed ? skValveDataFile::LoadMode::Windowed
+                                                                              : skValveDataFile::DefaultMode);
+
+      // Keep the old reader around if Steam was in the middle of writing the file
+      if (! refreshed->index.empty ())
+      {
+        std::vector <AppId_t> changed =
+          refreshed->supersede (*appinfo);
+
+        appinfo = std::move (refreshed);
+
+        for (auto appid : changed)
+        {
+          app_record_s* pChangedApp =
+            g_appRegistry.find (app_record_s::Store::Steam, appid);
+
+          if (pChangedApp == nullptr)
+            continue;
+
+          skValveDataFile::resetApp (pChangedApp);
+
+          PLOG_VERBOSE << "[AppInfo Processing] Reprocessing changed app " << appid;
+
+          // The selected game gets reprocessed right away
+          if (appid == selection.appid && selection.store == app_record_s::Store::Steam)
+            update = true;
+        }
+
+        // Resume processing of unprocessed games, including any the previous reader was cancelled on
+        steamFallback = false;
+      }
+    }
+
     if (steamRunning)
       steamFallback = false;
     
-    else if (! steamFallback && appinfo != nullptr)
+    // Nothing is processed while the library worker is running or the snapshot of the
+    //   last session is shown, as either way the records are about to be swapped out
+    else if (! steamFallback && appinfo != nullptr && library_worker == nullptr && ! snapshotShown)
     {
-      SK_RunOnce (PLOG_DEBUG << "[AppInfo Processing] Started processing games...");
-
-      bool fallbackAvailable = true;
+      // Swap in the results of a finished batch, if any
+      if (appinfo->publishApps (&g_apps))
+        PLOG_DEBUG << "[AppInfo Processing] Published a batch of processed games.";
 
-      for (auto& app : g_apps)
+      if (! appinfo->isProcessing ( ))
       {
-        if (app.second.store != app_record_s::Store::Steam)
-          continue;
+        std::vector <app_record_s*> pending;
 
-        if (app.second.id == 0)
-          continue;
+        for (auto& app : g_apps)
+        {
+          if (app.second.store != app_record_s::Store::Steam)
+            continue;
 
-        if (app.second.id == SKIF_STEAM_APPID)
-          continue;
+          if (app.second.id == 0)
+            continue;
 
-        if (app.second.processed)
-          continue;
-        
-        //PLOG_DEBUG << "[AppInfo Processing] " << "[" << ImGui::GetFrameCount ( ) << "] Processing " << app.second.id << "...";
-        appinfo->getAppInfo ( app.second.id, &g_apps );
+          if (app.second.id == SKIF_STEAM_APPID)
+            continue;
 
-        fallbackAvailable = false;
-        break;
-      }
+          if (app.second.processed)
+            continue;
+
+          pending.push_back (&app.second);
+        }
+
+        // All pending games are parsed in one batch on a set of worker threads
+        if (! pending.empty ())
+        {
+          SK_RunOnce (PLOG_DEBUG << "[AppInfo Processing] Started processing games...");
 
-      steamFallback = fallbackAvailable;
+          appinfo->processApps (pending);
+        }
+
+        else
+        {
+          steamFallback = true;
 
-      if (steamFallback)
-        SK_RunOnce (PLOG_DEBUG << "[AppInfo Processing] Finished processing games!");
+          SK_RunOnce (PLOG_DEBUG << "[AppInfo Processing] Finished processing games!");
+        }
+      }
     }
 
 #if 0
@@ -0,0 +1,431 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <utility/app_list.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <numeric>
+
+static std::atomic <uint32_t> SKIF_AppList_SortGeneration = 0;
+
+uint32_t
+SKIF_AppList_GetSortGeneration (void)
+{
+  return SKIF_AppList_SortGeneration.load ( );
+}
+
+void
+SKIF_AppList_BumpSortGeneration (void)
+{
+  SKIF_AppList_SortGeneration++;
+}
+
+std::string
+SKIF_AppList_GetEffectiveCategory (const app_record_s* app)
+{
+  return (    app->skif.pinned > 0 || (app->skif.pinned == -1 && app->steam.shared.favorite == 1))
+         ?   "Favorites"
+         : (! app->skif.category.empty())
+         ?    app->skif.category
+         :   "Games";
+}
+
+#pragma region Sorting
+
+// Pinned state used for sorting: SKIF's pinned value, or 0 / Steam's favorite state if SKIF's is unset
+static int
+SKIF_AppList_SortPinned (const app_record_s& app)
+{
+  return std::max (app.skif.pinned, (app.skif.pinned == -1) ? app.steam.shared.favorite : 0);
+}
+
+bool
+SKIF_AppList_SortsBefore (const app_record_s& a, const app_record_s& b, int sort)
+{
+  const int a_pinned = SKIF_AppList_SortPinned (a),
+            b_pinned = SKIF_AppList_SortPinned (b);
+
+  if (a_pinned != b_pinned)
+    return a_pinned > b_pinned;
+
+  if (a_pinned == 0)
+  {
+    if (a.skif.category.empty () != b.skif.category.empty ())
+      return b.skif.category.empty ();
+
+    if (int cmp = a.skif.category.compare (b.skif.category); cmp != 0)
+      return cmp < 0;
+  }
+
+  if (sort == 1 && a.skif.uses != b.skif.uses)
+    return a.skif.uses > b.skif.uses;
+
+  if (sort == 2)
+  {
+    if (int cmp = a.skif.used.compare (b.skif.used); cmp != 0)
+      return cmp > 0;
+  }
+
+  return a.names.all_upper_alnum.compare (b.names.all_upper_alnum) < 0;
+}
+
+// Ranks each value by where it sorts among all of them, equal values share a rank
+template <typename _Tp, typename _Less>
+static std::vector <uint32_t>
+SKIF_AppList_Rank (const std::vector <_Tp>& values, _Less less)
+{
+  std::vector <uint32_t> order (values.size ());
+  std::iota (order.begin (), order.end (), 0);
+
+  std::sort (order.begin (), order.end (),
+    [&](uint32_t a, uint32_t b)
+    {
+      return less (values [a], values [b]);
+    }
+  );
+
+  std::vector <uint32_t> ranks (values.size ());
+  uint32_t               rank = 0;
+
+  for (size_t i = 0; i < order.size (); i++)
+  {
+    if (i > 0 && less (values [order [i - 1]], values [order [i]]))
+      rank++;
+
+    ranks [order [i]] = rank;
+  }
+
+  return ranks;
+}
+
+// Every app gets a packed key, from the most to the least significant bits:
+//   pinned (7), category ordinal (16), used count or last used ordinal (20), name ordinal (20).
+//     Indices are sorted by key once and the result is applied as an in-place permutation,
+//       so the records only move once and the storage of the vector is left untouched.
+void
+SKIF_AppList_Sort (std::vector <std::pair <std::string, app_record_s> > *apps, int sort)
+{
+  SKIF_AppList_BumpSortGeneration ( );
+
+  const size_t count = apps->size ();
+
+  if (count < 2)
+    return;
+
+  std::vector <const std::string*> names      (count),
+                                   categories (count),
+                                   used       (count);
+  std::vector <int>                uses       (count);
+
+  for (size_t i = 0; i < count; i++)
+  {
+    const app_record_s& app = (*apps)[i].second;
+
+    names      [i] = &app.names.all_upper_alnum;
+    categories [i] = &app.skif.category;
+    used       [i] = &app.skif.used;
+    uses       [i] =  app.skif.uses;
+  }
+
+  auto _ByString = [](const std::string* a, const std::string* b) { return a->compare (*b) < 0; };
+
+  std::vector <uint32_t> name_ranks =
+    SKIF_AppList_Rank (names, _ByString);
+
+  // Uncategorized entries go last
+  std::vector <uint32_t> category_ranks =
+    SKIF_AppList_Rank (categories, [](const std::string* a, const std::string* b)
+    {
+      if (a->empty () != b->empty ())
+        return b->empty ();
+
+      return a->compare (*b) < 0;
+    });
+
+  // Both used count and last used sort in descending order
+  std::vector <uint32_t> usage_ranks =
+      (sort == 1) ? SKIF_AppList_Rank (uses, [](int a, int b) { return a > b; })
+    : (sort == 2) ? SKIF_AppList_Rank (used, [](const std::string* a, const std::string* b) { return a->compare (*b) > 0; })
+                  : std::vector <uint32_t> (count, 0);
+
+  std::vector <std::pair <uint64_t, uint32_t> > keys (count);
+
+  for (size_t i = 0; i < count; i++)
+  {
+    const int pinned =
+      std::clamp (SKIF_AppList_SortPinned ((*apps)[i].second), 0, 0x7F);
+
+    // Categories only apply to unpinned entries
+    const uint64_t category = (pinned == 0) ? std::min <uint32_t> (category_ranks [i],    0xFFFF) : 0;
+    const uint64_t usage    =                 std::min <uint32_t> (usage_ranks    [i],   0xFFFFF);
+    const uint64_t name     =                 std::min <uint32_t> (name_ranks     [i],   0xFFFFF);
+
+    keys [i] = {
+      (static_cast <uint64_t> (0x7F - pinned) << 56) | (category << 40) | (usage << 20) | name,
+       static_cast <uint32_t> (i)
+    };
+  }
+
+  // The index breaks ties, which keeps the sort stable
+  std::sort (keys.begin (), keys.end ());
+
+  // Apply the permutation one cycle at a time: position i receives the app at keys [i].second
+  std::vector <bool> placed (count, false);
+
+  for (size_t i = 0; i < count; i++)
+  {
+    if (placed [i] || keys [i].second == i)
+      continue;
+
+    auto   tmp = std::move ((*apps)[i]);
+    size_t pos = i;
+
+    while (true)
+    {
+      const size_t from = keys [pos].second;
+
+      placed [pos] = true;
+
+      if (from == i)
+      {
+        (*apps)[pos] = std::move (tmp);
+        break;
+      }
+
+      (*apps)[pos] = std::move ((*apps)[from]);
+      pos          = from;
+    }
+  }
+}
+
+void
+SKIF_AppList_Reposition (std::vector <std::pair <std::string, app_record_s> > *apps, const app_record_s* app, int sort)
+{
+  auto it =
+    std::find_if (apps->begin (), apps->end (), [&](const std::pair <std::string, app_record_s>& item) { return &item.second == app; });
+
+  if (it == apps->end ())
+    return;
+
+  SKIF_AppList_BumpSortGeneration ( );
+
+  auto _Less = [sort](const std::pair <std::string, app_record_s>& a,
+                      const std::pair <std::string, app_record_s>& b) -> bool
+  {
+    return SKIF_AppList_SortsBefore (a.second, b.second, sort);
+  };
+
+  // The rest of the list is still sorted, so the new position is on either side of the app.
+  //   Apps that compare equal keep their relative order, as they would in a full (stable) sort:
+  //     the app ends up after equal apps that were before it, and before those that were after it.
+  auto dest =
+    std::upper_bound (apps->begin (), it, *it, _Less);
+
+  if (dest != it)
+    std::rotate (dest, it, it + 1);
+
+  else
+  {
+    dest =
+      std::lower_bound (it + 1, apps->end (), *it, _Less);
+
+    std::rotate (it, it + 1, dest);
+  }
+}
+
+#pragma endregion
+
+#pragma region App Registry
+
+static uint64_t
+SKIF_AppRegistry_Key (app_record_s::Store store, uint32_t id)
+{
+  return (static_cast <uint64_t> (store) << 32) | id;
+}
+
+void
+SKIF_AppRegistry::_rebuild (void)
+{
+  _ids .clear ();
+  _epic.clear ();
+  _xbox.clear ();
+
+  _ids.reserve (_apps->size ());
+
+  for (size_t i = 0; i < _apps->size (); i++)
+  {
+    auto& record = (*_apps)[i].second;
+
+    // Uninstalled, hidden and otherwise filtered out apps
+    if (record.id == 0)
+      continue;
+
+    // The first entry wins if an app is listed more than once
+    _ids.emplace (SKIF_AppRegistry_Key (record.store, record.id), i);
+
+    if (record.store == app_record_s::Store::Epic && ! record.epic.name_app.empty ())
+      _epic.emplace (record.epic.name_app, i);
+
+    else if (record.store == app_record_s::Store::Xbox && ! record.xbox.package_name.empty ())
+      _xbox.emplace (record.xbox.package_name, i);
+  }
+
+  _size  = _apps->size ();
+  _dirty = false;
+}
+
+template <typename _Key, typename _Match>
+app_record_s*
+SKIF_AppRegistry::_lookup (const std::unordered_map <_Key, size_t>& index, const _Key& key, _Match match)
+{
+  // Retry once with a fresh index if the list was changed or reordered since it was built
+  for (int attempt = 0; attempt < 2; attempt++)
+  {
+    if (_dirty || _size != _apps->size ())
+      _rebuild ( );
+
+    auto it =
+      index.find (key);
+
+    if (it == index.end ())
+      return nullptr;
+
+    if (it->second < _apps->size () && match ((*_apps)[it->second].second))
+      return &(*_apps)[it->second].second;
+
+    _dirty = true;
+  }
+
+  return nullptr;
+}
+
+app_record_s*
+SKIF_AppRegistry::find (app_record_s::Store store, uint32_t id)
+{
+  if (id == 0)
+    return nullptr;
+
+  return
+    _lookup (_ids, SKIF_AppRegistry_Key (store, id), [&](const app_record_s& record) {
+      return record.id == id && record.store == store;
+    });
+}
+
+app_record_s*
+SKIF_AppRegistry::findEpic (const std::string& name_app)
+{
+  return
+    _lookup (_epic, name_app, [&](const app_record_s& record) {
+      return record.store == app_record_s::Store::Epic && record.epic.name_app == name_app;
+    });
+}
+
+app_record_s*
+SKIF_AppRegistry::findXbox (const std::string& package_name)
+{
+  return
+    _lookup (_xbox, package_name, [&](const app_record_s& record) {
+      return record.store == app_record_s::Store::Xbox && record.xbox.package_name == package_name;
+    });
+}
+
+app_record_s*
+SKIF_AppRegistry::findByKey (app_record_s::Store store, const std::string& key)
+{
+  if (store == app_record_s::Store::Epic)
+    return findEpic (key);
+
+  if (store == app_record_s::Store::Xbox)
+    return findXbox (key);
+
+  uint32_t id = 0;
+
+  if (std::from_chars (key.data (), key.data () + key.size (), id).ec != std::errc { })
+    return nullptr;
+
+  return find (store, id);
+}
+
+#pragma endregion
+
+#pragma region App List View
+
+void
+SKIF_AppListView::_rebuild (void)
+{
+  _entries   .clear ();
+  _categories.clear ();
+
+  _entries.reserve (_apps->size ());
+
+  for (auto& app : *_apps)
+  {
+    std::string effective =
+      SKIF_AppList_GetEffectiveCategory (&app.second);
+
+    // There are only a handful of categories, and sorted apps mostly repeat the previous one
+    size_t idx = _categories.size ();
+
+    for (size_t i = _categories.size (); i > 0; i--)
+    {
+      if (_categories [i - 1] == effective)
+      {
+        idx = i - 1;
+        break;
+      }
+    }
+
+    if (idx == _categories.size ())
+      _categories.emplace_back (std::move (effective));
+
+    _entries.push_back ({
+      &app,
+       app.second.id,
+       app.second.store,
+       app.second.skif.pinned,
+       static_cast <uint16_t> (idx),
+       app.second.filtered,
+       app.second.tex_icon.iWorker == 1
+    });
+  }
+
+  _data       = _apps->data ();
+  _size       = _apps->size ();
+  _generation = SKIF_AppList_GetSortGeneration ( );
+  _dirty      = false;
+}
+
+std::vector <SKIF_AppListView::entry_s>&
+SKIF_AppListView::entries (void)
+{
+  if (_dirty                                                    ||
+      _data       != _apps->data ()                             ||
+      _size       != _apps->size ()                             ||
+      _generation != SKIF_AppList_GetSortGeneration ( ))
+    _rebuild ( );
+
+  return _entries;
+}
+
+#pragma endregion
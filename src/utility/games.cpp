@@ -8,13 +8,15 @@
 #include <filesystem>
 #include <string>
 #include <sstream>
+#include <charconv>
 #include <concurrent_queue.h>
 
 #include <utility/games.h>
 #include <SKIF.h>
 #include <utility/utility.h>
-#include "stores/Steam/apps_ignore.h"
 #include <utility/fsutil.h>
+#include <utility/binary_cache.h>
+#include <utility/library_snapshot.h>
 #include <stores/GOG/gog_library.h>
 #include <stores/epic/epic_library.h>
 #include <stores/Xbox/xbox_library.h>
@@ -212,101 +214,89 @@ SKIF_GamingCollection::SortApps (std::vector <std::pair <std::string, app_record
 {
   static SKIF_RegistrySettings& _registry   = SKIF_RegistrySettings::GetInstance ( );
 
-  // The base sort is by name
-  std::stable_sort ( apps->begin (),
-                     apps->end   (),
-    []( const std::pair <std::string, app_record_s>& a,
-        const std::pair <std::string, app_record_s>& b ) -> int
-    {
-      return a.second.names.all_upper_alnum.compare(
-             b.second.names.all_upper_alnum
-      ) < 0;
-    }
-  );
-
-  // Then we apply any overarching custom sort
   switch (_registry.iLibrarySort)
   {
-
-  case 1: // Sorting by used count
+  case 1:
     PLOG_VERBOSE << "Sorting by used count...";
-    std::stable_sort ( apps->begin (),
-                       apps->end   (),
-      []( const std::pair <std::string, app_record_s>& a,
-          const std::pair <std::string, app_record_s>& b ) -> int
-      {
-        return a.second.skif.uses >
-               b.second.skif.uses;
-      }
-    );
     break;
-
-  case 2: // Sorting by last used
+  case 2:
     PLOG_VERBOSE << "Sorting by last used...";
-    std::stable_sort ( apps->begin (),
-                       apps->end   (),
-      []( const std::pair <std::string, app_record_s>& a,
-          const std::pair <std::string, app_record_s>& b ) -> int
-      {
-        return a.second.skif.used.compare(
-               b.second.skif.used
-        ) > 0;
-      }
-    );
     break;
   }
 
-  // Now we sort by the pinned state
-  std::stable_sort ( apps->begin (),
-                     apps->end   (),
-    []( const std::pair <std::string, app_record_s>& a,
-        const std::pair <std::string, app_record_s>& b ) -> int
-    {
-      // Use the highest value between SKIF's pinned value, or 0 / Steam's pinned value if SKIF's is unset
-      return std::max (a.second.skif.pinned, (a.second.skif.pinned == -1) ? a.second.steam.shared.favorite : 0) >
-             std::max (b.second.skif.pinned, (b.second.skif.pinned == -1) ? b.second.steam.shared.favorite : 0);
-    }
-  );
+  SKIF_AppList_Sort (apps, _registry.iLibrarySort);
+}
 
-  // We need an iterator at the unpinned entries to sort the rest separately
-  auto   it  = apps->begin ();
-  while (it != apps->end   ())
-  {
-    auto& item = *it;
-    if (std::max (item.second.skif.pinned, (item.second.skif.pinned == -1) ? item.second.steam.shared.favorite : 0) == 0)
-      break;
+void
+SKIF_GamingCollection::RepositionApp (std::vector <std::pair <std::string, app_record_s> > *apps, const app_record_s* app)
+{
+  static SKIF_RegistrySettings& _registry   = SKIF_RegistrySettings::GetInstance ( );
 
-    it++;
-  }
+  SKIF_AppList_Reposition (apps, app, _registry.iLibrarySort);
+}
 
-  // Then sort unpinned entires by category
-  std::stable_sort ( it,
-                     apps->end   (),
-    []( const std::pair <std::string, app_record_s>& a,
-        const std::pair <std::string, app_record_s>& b ) -> int
-    {
-      return a.second.skif.category.compare(
-             b.second.skif.category) < 0;
-    }
-  );
 
-  // And move all uncategorized entries last
-  std::stable_partition ( it,
-                          apps->end   (),
-    []( const std::pair <std::string, app_record_s>& a ) -> bool
-    {
-      return ! a.second.skif.category.empty();
-    }
-  );
+
+#pragma region Library Snapshot
+
+static std::wstring
+SKIF_LibrarySnapshot_GetPath (void)
+{
+  static SKIF_CommonPathsCache& _path_cache = SKIF_CommonPathsCache::GetInstance ( );
+
+  return SK_FormatStringW (LR"(%ws\Assets\library.cache)", _path_cache.specialk_userdata);
+}
+
+// A snapshot is only valid for the same set of enabled platforms and sorting options
+static uint32_t
+SKIF_LibrarySnapshot_GetFlags (void)
+{
+  static SKIF_RegistrySettings& _registry = SKIF_RegistrySettings::GetInstance ( );
+
+  return (_registry.bLibrarySteam          ? 0x01 : 0x0) |
+         (_registry.bLibraryGOG            ? 0x02 : 0x0) |
+         (_registry.bLibraryEpic           ? 0x04 : 0x0) |
+         (_registry.bLibraryXbox           ? 0x08 : 0x0) |
+         (_registry.bLibraryCustom         ? 0x10 : 0x0) |
+         (_registry.bLibraryIgnoreArticles ? 0x20 : 0x0);
+}
+
+bool
+SKIF_GamingCollection::SaveSnapshot (const std::vector <std::pair <std::string, app_record_s> > *apps, const std::set <std::string> *apptickets)
+{
+  SKIF_BinaryWriter out;
+
+  SKIF_LibrarySnapshot_Serialize (out, SKIF_LibrarySnapshot_GetFlags ( ), apps, apptickets);
+
+  if (! out.save (SKIF_LibrarySnapshot_GetPath ( )))
+  {
+    PLOG_ERROR << "Failed to save the library snapshot!";
+    return false;
+  }
+
+  return true;
 }
 
+bool
+SKIF_GamingCollection::LoadSnapshot (std::vector <std::pair <std::string, app_record_s> > *apps, std::set <std::string> *apptickets)
+{
+  std::vector <BYTE> buffer;
+
+  if (! SKIF_BinaryReader::load (SKIF_LibrarySnapshot_GetPath ( ), buffer))
+    return false;
 
+  SKIF_BinaryReader in { buffer.data (), buffer.data () + buffer.size () };
 
+  return
+    SKIF_LibrarySnapshot_Deserialize (in, SKIF_LibrarySnapshot_GetFlags ( ), apps, apptickets);
+}
+
+#pragma endregion
 
 #pragma region RefreshRunningApps
 
 void
-SKIF_GamingCollection::RefreshRunningApps (std::vector <std::pair <std::string, app_record_s> > *apps)
+SKIF_GamingCollection::RefreshRunningApps (std::vector <std::pair <std::string, app_record_s> > *apps, SKIF_AppRegistry* registry)
 {
   static SKIF_RegistrySettings& _registry   = SKIF_RegistrySettings::GetInstance ( );
   static SKIF_CommonPathsCache& _path_cache = SKIF_CommonPathsCache::GetInstance ( );
@@ -493,29 +483,53 @@ SKIF_GamingCollection::RefreshRunningApps (std::vector <std::pair <std::string,
       HANDLE hWorkerThread = monitored_app.hWorkerThread.load();
       int    iReturnCode   = monitored_app.iReturnCode.load();
 
-      for (auto& app : *apps)
+      app_record_s* pApp =
+        registry->find (static_cast <app_record_s::Store> (monitored_app.store_id), monitored_app.id);
+
+      if (pApp != nullptr)
       {
-        if (monitored_app.id       ==      app.second.id &&
-            monitored_app.store_id == (int)app.second.store)
+        pApp->_status.running = 1;
+
+        // Failed start -- let's clean up the wrong data
+        if (iReturnCode > 0)
         {
-          app.second._status.running = 1;
+          PLOG_ERROR << "Worker thread for launching app ID " << monitored_app.id << " from platform ID " << monitored_app.store_id << " failed!";
+          pApp->_status.running     =  0;
+
+          monitored_app.id               =  0;
+          monitored_app.store_id         = -1;
+          monitored_app.iReturnCode.store (-1);
 
-          // Failed start -- let's clean up the wrong data
-          if (iReturnCode > 0)
+          if (hProcess != INVALID_HANDLE_VALUE)
           {
-            PLOG_ERROR << "Worker thread for launching app ID " << monitored_app.id << " from platform ID " << monitored_app.store_id << " failed!";
-            app.second._status.running     =  0;
+            CloseHandle (hProcess);
+            hProcess = INVALID_HANDLE_VALUE;
+            monitored_app.hProcess.store(INVALID_HANDLE_VALUE);
+          }
 
-            monitored_app.id               =  0;
-            monitored_app.store_id         = -1;
-            monitored_app.iReturnCode.store (-1);
+          // Clean up these as well if they haven't been done so yet
+          if (hWorkerThread != INVALID_HANDLE_VALUE)
+          {
+            CloseHandle(hWorkerThread);
+            hWorkerThread = INVALID_HANDLE_VALUE;
+            monitored_app.hWorkerThread.store(INVALID_HANDLE_VALUE);
+          }
+        }
 
-            if (hProcess != INVALID_HANDLE_VALUE)
-            {
-              CloseHandle (hProcess);
-              hProcess = INVALID_HANDLE_VALUE;
-              monitored_app.hProcess.store(INVALID_HANDLE_VALUE);
-            }
+        // Monitor the external process primarily
+        if (hProcess != INVALID_HANDLE_VALUE)
+        {
+          if (WAIT_OBJECT_0 == WaitForSingleObject (hProcess, 0))
+          {
+            PLOG_DEBUG << "Game process for app ID " << monitored_app.id << " from platform ID " << monitored_app.store_id << " has ended!";
+            pApp->_status.running = 0;
+
+            monitored_app.id              =  0;
+            monitored_app.store_id        = -1;
+
+            CloseHandle (hProcess);
+            hProcess = INVALID_HANDLE_VALUE;
+            monitored_app.hProcess.store(INVALID_HANDLE_VALUE);
 
             // Clean up these as well if they haven't been done so yet
             if (hWorkerThread != INVALID_HANDLE_VALUE)
@@ -525,43 +539,18 @@ SKIF_GamingCollection::RefreshRunningApps (std::vector <std::pair <std::string,
               monitored_app.hWorkerThread.store(INVALID_HANDLE_VALUE);
             }
           }
-
-          // Monitor the external process primarily
-          if (hProcess != INVALID_HANDLE_VALUE)
-          {
-            if (WAIT_OBJECT_0 == WaitForSingleObject (hProcess, 0))
-            {
-              PLOG_DEBUG << "Game process for app ID " << monitored_app.id << " from platform ID " << monitored_app.store_id << " has ended!";
-              app.second._status.running = 0;
-
-              monitored_app.id              =  0;
-              monitored_app.store_id        = -1;
-
-              CloseHandle (hProcess);
-              hProcess = INVALID_HANDLE_VALUE;
-              monitored_app.hProcess.store(INVALID_HANDLE_VALUE);
-
-              // Clean up these as well if they haven't been done so yet
-              if (hWorkerThread != INVALID_HANDLE_VALUE)
-              {
-                CloseHandle(hWorkerThread);
-                hWorkerThread = INVALID_HANDLE_VALUE;
-                monitored_app.hWorkerThread.store(INVALID_HANDLE_VALUE);
-              }
-            }
-          }
-          
-          // If we cannot monitor the game process, monitor the worker thread
-          if (hWorkerThread != INVALID_HANDLE_VALUE)
+        }
+        
+        // If we cannot monitor the game process, monitor the worker thread
+        if (hWorkerThread != INVALID_HANDLE_VALUE)
+        {
+          if (WAIT_OBJECT_0 == WaitForSingleObject (hWorkerThread, 0))
           {
-            if (WAIT_OBJECT_0 == WaitForSingleObject (hWorkerThread, 0))
-            {
-              PLOG_DEBUG << "Worker thread for launching app ID " << monitored_app.id << " from platform ID " << monitored_app.store_id << " has ended!";
+            PLOG_DEBUG << "Worker thread for launching app ID " << monitored_app.id << " from platform ID " << monitored_app.store_id << " has ended!";
 
-              CloseHandle (hWorkerThread);
-              hWorkerThread = INVALID_HANDLE_VALUE;
-              monitored_app.hWorkerThread.store(INVALID_HANDLE_VALUE);
-            }
+            CloseHandle (hWorkerThread);
+            hWorkerThread = INVALID_HANDLE_VALUE;
+            monitored_app.hWorkerThread.store(INVALID_HANDLE_VALUE);
           }
         }
       }
@@ -0,0 +1,292 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <utility/library_snapshot.h>
+#include <utility/utility.h>
+#include <plog/Log.h>
+
+#include <algorithm>
+
+// Bump the version whenever the layout of the snapshot changes
+#define SKIF_LIBRARY_SNAPSHOT_MAGIC   0x534C4B53 // 'SKLS'
+#define SKIF_LIBRARY_SNAPSHOT_VERSION 1
+
+// The custom launch configs merged into the launch configs of a processed Steam app are
+//   skipped with skip_custom, as they are persisted on their own in launch_configs_custom
+static void
+SKIF_LibrarySnapshot_Write (SKIF_BinaryWriter& out, const std::map <int, app_record_s::launch_config_s>& launch_configs, bool skip_custom = false)
+{
+  auto _IsSkipped = [&](const app_record_s::launch_config_s& launch) -> bool
+  {
+    return skip_custom && (launch.custom_skif || launch.custom_user);
+  };
+
+  out.pod <uint32_t> ((uint32_t)std::count_if (launch_configs.begin (), launch_configs.end (),
+                                                [&](const auto& launch) { return ! _IsSkipped (launch.second); }));
+
+  for (auto& launch : launch_configs)
+  {
+    if (_IsSkipped (launch.second))
+      continue;
+
+    out.pod <int32_t>  (launch.first);
+    out.pod <int32_t>  (launch.second.id);
+    out.pod <int32_t>  (launch.second.id_steam);
+    out.pod <uint32_t> ((uint32_t)launch.second.type);
+    out.pod <uint32_t> ((uint32_t)launch.second.cpu_type);
+    out.pod <uint32_t> ((uint32_t)launch.second.platforms);
+    out.str            (launch.second.executable);
+    out.str            (launch.second.executable_path);
+    out.str            (launch.second.install_dir);
+    out.str            (launch.second.Xbox_ApplicationId);
+    out.str            (launch.second.executable_helper);
+    out.str            (launch.second.description);
+    out.str            (launch.second.launch_options);
+    out.str            (launch.second.working_dir);
+    out.str            (launch.second.requires_dlc);
+    out.pod <int32_t>  (launch.second.valid);
+    out.pod <uint8_t>  (launch.second.custom_skif);
+    out.pod <uint8_t>  (launch.second.custom_user);
+
+    out.pod <uint32_t> ((uint32_t)launch.second.branches.size ());
+
+    for (auto& branch : launch.second.branches)
+      out.str (branch);
+  }
+}
+
+static void
+SKIF_LibrarySnapshot_Read (SKIF_BinaryReader& in, std::map <int, app_record_s::launch_config_s>& launch_configs)
+{
+  for (uint32_t i = 0, count = in.pod <uint32_t> ( ); i < count && in.ok; i++)
+  {
+    auto& launch =
+      launch_configs [in.pod <int32_t> ( )];
+
+    launch.id                 = in.pod <int32_t> ( );
+    launch.id_steam           = in.pod <int32_t> ( );
+    launch.type               = static_cast <app_record_s::launch_config_s::Type> (in.pod <uint32_t> ( ));
+    launch.cpu_type           = static_cast <app_record_s::CPUType>               (in.pod <uint32_t> ( ));
+    launch.platforms          = static_cast <app_record_s::Platform>              (in.pod <uint32_t> ( ));
+    launch.executable         = in.wstr ( );
+    launch.executable_path    = in.wstr ( );
+    launch.install_dir        = in.wstr ( );
+    launch.Xbox_ApplicationId = in.str  ( );
+    launch.executable_helper  = in.wstr ( );
+    launch.description        = in.wstr ( );
+    launch.launch_options     = in.wstr ( );
+    launch.working_dir        = in.wstr ( );
+    launch.requires_dlc       = in.str  ( );
+    launch.valid              = in.pod <int32_t> ( );
+    launch.custom_skif        = in.pod <uint8_t> ( ) != 0;
+    launch.custom_user        = in.pod <uint8_t> ( ) != 0;
+
+    for (uint32_t j = 0, branches = in.pod <uint32_t> ( ); j < branches && in.ok; j++)
+      launch.branches.emplace (in.str ( ));
+  }
+}
+
+void
+SKIF_LibrarySnapshot_Serialize (SKIF_BinaryWriter& out, uint32_t flags, const std::vector <std::pair <std::string, app_record_s> > *apps, const std::set <std::string> *apptickets)
+{
+  out.pod <uint32_t> (SKIF_LIBRARY_SNAPSHOT_MAGIC);
+  out.pod <uint32_t> (SKIF_LIBRARY_SNAPSHOT_VERSION);
+  out.pod <uint32_t> (flags);
+
+  size_t count_pos = out.buf.size ();
+  out.pod <uint32_t> (0);
+
+  uint32_t count = 0;
+
+  for (auto& app : *apps)
+  {
+    auto& record = app.second;
+
+    // Uninstalled, hidden and otherwise filtered out apps
+    if (record.id == 0)
+      continue;
+
+    out.str            (app.first);
+    out.pod <uint32_t> (record.id);
+    out.pod <uint32_t> ((uint32_t)record.store);
+    out.str            (record.store_utf8);
+    out.str            (record.install_dir);
+
+    out.str            (record.names.original);
+    out.str            (record.names.clean);
+    out.str            (record.names.normal);
+    out.str            (record.names.all_upper);
+
+    out.str            (record.skif.name);
+    out.pod <int32_t>  (record.skif.cpu_type);
+    out.pod <int32_t>  (record.skif.instant_play);
+    out.pod <int32_t>  (record.skif.auto_stop);
+    out.pod <int32_t>  (record.skif.uses);
+    out.str            (record.skif.used);
+    out.str            (record.skif.used_formatted);
+    out.str            (record.skif.category);
+    out.pod <int32_t>  (record.skif.hidden);
+    out.pod <int32_t>  (record.skif.pinned);
+
+    out.str            (record.steam.local.launch_option);
+    out.pod <int32_t>  (record.steam.shared.hidden);
+    out.pod <int32_t>  (record.steam.shared.favorite);
+    out.str            (record.steam.branch);
+
+    out.pod <uint32_t> ((uint32_t)record.steam.shared.tags.size ());
+
+    for (auto& tag : record.steam.shared.tags)
+      out.str (tag);
+
+    out.str            (record.epic.catalog_namespace);
+    out.str            (record.epic.catalog_item_id);
+    out.str            (record.epic.name_app);
+    out.str            (record.epic.name_display);
+
+    out.str            (record.xbox.package_name);
+    out.str            (record.xbox.package_name_full);
+    out.str            (record.xbox.package_name_family);
+    out.str            (record.xbox.store_id);
+    out.str            (record.xbox.directory_app);
+    out.str            (record.xbox.directory_program_files);
+
+    out.str            (record.specialk.profile_dir);
+
+    SKIF_LibrarySnapshot_Write (out, record.launch_configs, record.store == app_record_s::Store::Steam);
+    SKIF_LibrarySnapshot_Write (out, record.launch_configs_custom);
+
+    count++;
+  }
+
+  memcpy (out.buf.data () + count_pos, &count, sizeof (count));
+
+  out.pod <uint32_t> ((uint32_t)apptickets->size ());
+
+  for (auto& appticket : *apptickets)
+    out.str (appticket);
+
+  PLOG_VERBOSE << "Wrote " << count << " apps to the library snapshot";
+}
+
+bool
+SKIF_LibrarySnapshot_Deserialize (SKIF_BinaryReader& in, uint32_t flags, std::vector <std::pair <std::string, app_record_s> > *apps, std::set <std::string> *apptickets)
+{
+  if (in.pod <uint32_t> ( ) != SKIF_LIBRARY_SNAPSHOT_MAGIC   ||
+      in.pod <uint32_t> ( ) != SKIF_LIBRARY_SNAPSHOT_VERSION ||
+      in.pod <uint32_t> ( ) != flags)
+  {
+    PLOG_INFO << "Discarding outdated or unrecognized library snapshot";
+    return false;
+  }
+
+  std::vector <std::pair <std::string, app_record_s> > snapshot;
+  std::set    <std::string>                            tickets;
+
+  for (uint32_t i = 0, count = in.pod <uint32_t> ( ); i < count && in.ok; i++)
+  {
+    std::string  name = in.str ( );
+    app_record_s record (in.pod <uint32_t> ( ));
+
+    record.store                     = static_cast <app_record_s::Store> (in.pod <uint32_t> ( ));
+    record.store_utf8                = in.str  ( );
+    record.install_dir               = in.wstr ( );
+
+    record.names.original            = in.str  ( );
+    record.names.clean               = in.str  ( );
+    record.names.normal              = in.str  ( );
+    record.names.all_upper           = in.str  ( );
+
+    record.skif.name                 = in.str  ( );
+    record.skif.cpu_type             = in.pod <int32_t> ( );
+    record.skif.instant_play         = in.pod <int32_t> ( );
+    record.skif.auto_stop            = in.pod <int32_t> ( );
+    record.skif.uses                 = in.pod <int32_t> ( );
+    record.skif.used                 = in.str  ( );
+    record.skif.used_formatted       = in.str  ( );
+    record.skif.category             = in.str  ( );
+    record.skif.hidden               = in.pod <int32_t> ( );
+    record.skif.pinned               = in.pod <int32_t> ( );
+
+    record.steam.local.launch_option = in.str  ( );
+    record.steam.shared.hidden       = in.pod <int32_t> ( );
+    record.steam.shared.favorite     = in.pod <int32_t> ( );
+    record.steam.branch              = in.str  ( );
+
+    for (uint32_t j = 0, tags = in.pod <uint32_t> ( ); j < tags && in.ok; j++)
+      record.steam.shared.tags.push_back (in.str ( ));
+
+    record.epic.catalog_namespace    = in.str  ( );
+    record.epic.catalog_item_id      = in.str  ( );
+    record.epic.name_app             = in.str  ( );
+    record.epic.name_display         = in.str  ( );
+
+    record.xbox.package_name            = in.str  ( );
+    record.xbox.package_name_full       = in.str  ( );
+    record.xbox.package_name_family     = in.str  ( );
+    record.xbox.store_id                = in.str  ( );
+    record.xbox.directory_app           = in.wstr ( );
+    record.xbox.directory_program_files = in.wstr ( );
+
+    record.specialk.profile_dir      = in.wstr ( );
+    record.specialk.profile_dir_utf8 = SK_WideCharToUTF8 (record.specialk.profile_dir);
+
+    SKIF_LibrarySnapshot_Read (in, record.launch_configs);
+    SKIF_LibrarySnapshot_Read (in, record.launch_configs_custom);
+
+    // Merge the custom launch configs back in the same way processing the app does
+    if (record.store == app_record_s::Store::Steam && ! record.launch_configs.empty ())
+    {
+      for (auto& custom_cfg : record.launch_configs_custom)
+      {
+        app_record_s::launch_config_s launch = custom_cfg.second;
+
+        launch.id       = static_cast <int> (record.launch_configs.size ());
+        launch.id_steam = -1;
+
+        record.launch_configs.emplace (launch.id, std::move (launch));
+      }
+    }
+
+    // Only installed apps make it into a snapshot
+    record._status.installed = true;
+    record.ImGuiLabelID      = SKIF_Util_FormatStringRaw ("###%i-%i-selectable", (int)record.store, record.id);
+    record.ImGuiPushID       = SKIF_Util_FormatStringRaw ("###%i-%i",            (int)record.store, record.id);
+
+    snapshot.emplace_back (std::move (name), std::move (record));
+  }
+
+  for (uint32_t i = 0, count = in.pod <uint32_t> ( ); i < count && in.ok; i++)
+    tickets.emplace (in.str ( ));
+
+  if (! in.ok)
+  {
+    PLOG_WARNING << "The library snapshot is truncated or corrupt, ignoring it!";
+    return false;
+  }
+
+  *apps       = std::move (snapshot);
+  *apptickets = std::move (tickets);
+
+  PLOG_INFO << "Loaded " << apps->size () << " apps from the library snapshot";
+
+  return true;
+}
@@ -345,6 +345,9 @@ SKIF_RegistrySettings::SKIF_RegistrySettings (void)
   if (regKVLibraryCustom.hasData(&hKey))
     bLibraryCustom         =   regKVLibraryCustom          .getData (&hKey);
 
+  if (regKVSteamAppInfoWindowed.hasData(&hKey))
+    bSteamAppInfoWindowed  =   regKVSteamAppInfoWindowed   .getData (&hKey);
+
   uiSteamUser              =   regKVSteamUser              .getData (&hKey);
 
 //bMiniMode             =   regKVServiceMode            .getData (&hKey);
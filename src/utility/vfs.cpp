@@ -1,5 +1,7 @@
 #include <utility/vfs.h>
 
+#include <algorithm>
+
 int
 SK_CountWChars (const wchar_t *s, wchar_t c)
 {
@@ -10,3 +12,161 @@ SK_CountWChars (const wchar_t *s, wchar_t c)
   SK_CountWChars (s + 1, c) +
                ( *s  ==  c );
 }
+
+void
+SK_VirtualFS::reset (void)
+{
+  _files.clear       ();
+  _dirs .clear       ();
+  _names.clear       ();
+  _name_blocks.clear ();
+  _name_used     = 0;
+  _name_capacity = 0;
+
+  root =
+    &_dirs.emplace_back (L"( VFS Root )", 12);
+  root->vfs = this;
+
+  name = L"Uninitialized VFS";
+}
+
+const wchar_t*
+SK_VirtualFS::_intern (std::wstring_view str)
+{
+  auto it =
+    _names.find (str);
+
+  if (it != _names.end ())
+    return it->data ();
+
+  static constexpr size_t _BlockSize = 16384;
+
+  // Names are null-terminated so they can be handed to C APIs as-is
+  if (_name_used + str.size () + 1 > _name_capacity)
+  {
+    _name_capacity = std::max (_BlockSize, str.size () + 1);
+    _name_used     = 0;
+
+    _name_blocks.emplace_back (
+      std::make_unique <wchar_t []> (_name_capacity)
+    );
+  }
+
+  wchar_t* interned =
+    _name_blocks.back ().get () + _name_used;
+
+  std::wmemcpy (interned, str.data (), str.size ());
+                interned [str.size ()] = L'\0';
+
+  _name_used += str.size () + 1;
+
+  _names.emplace (interned, str.size ());
+
+  return interned;
+}
+
+SK_VirtualFS::vfsNode*
+SK_VirtualFS::vfsNode::find (std::wstring_view wszName) const
+{
+  auto it =
+    std::lower_bound ( children.cbegin (), children.cend (), wszName,
+      [](const vfsNode* pNode, std::wstring_view str)
+      {
+        return std::wstring_view (pNode->name, pNode->length) < str;
+      }
+    );
+
+  if (it != children.cend () && std::wstring_view ((*it)->name, (*it)->length) == wszName)
+    return *it;
+
+  return nullptr;
+}
+
+SK_VirtualFS::vfsNode*
+SK_VirtualFS::vfsNode::_addChild (std::wstring_view wszName, vfsNode::type type)
+{
+  auto it =
+    std::lower_bound ( children.begin (), children.end (), wszName,
+      [](const vfsNode* pNode, std::wstring_view str)
+      {
+        return std::wstring_view (pNode->name, pNode->length) < str;
+      }
+    );
+
+  if (it != children.end () && std::wstring_view ((*it)->name, (*it)->length) == wszName)
+  {
+    if ((*it)->type_ == type)
+      return *it;
+
+    // Same name, different type; replace it (not expected to happen on disk)
+    it = children.erase (it);
+  }
+
+  const wchar_t* interned =
+    vfs->_intern (wszName);
+
+  vfsNode* pNode =
+    (type == vfsNode::type::File) ?
+      static_cast <vfsNode *> (&vfs->_files.emplace_back (interned, wszName.size ())) :
+      static_cast <vfsNode *> (&vfs->_dirs .emplace_back (interned, wszName.size ()));
+
+  pNode->parent = this;
+  pNode->vfs    = vfs;
+
+  children.insert (it, pNode);
+
+  return pNode;
+}
+
+SK_VirtualFS::File*
+SK_VirtualFS::vfsNode::addFile (const wchar_t* wszName)
+{
+  std::wstring_view path (wszName);
+
+  vfsNode* pDir = this;
+
+  // Walk (and create) the intermediate directories without copying the path
+  for (size_t sep  = path.find_first_of (LR"(\/)");
+              sep != std::wstring_view::npos;
+              sep  = path.find_first_of (LR"(\/)"))
+  {
+    if (sep > 0)
+      pDir = pDir->_addChild (path.substr (0, sep), vfsNode::type::Directory);
+
+    path.remove_prefix (sep + 1);
+  }
+
+  return
+    static_cast <File *> (pDir->_addChild (path, vfsNode::type::File));
+}
+
+SK_VirtualFS::Directory*
+SK_VirtualFS::vfsNode::addDirectory (const wchar_t* wszName)
+{
+  // The name is used as-is, e.g. SK_VFS_ScanTree adds whole paths as a single directory
+  return
+    static_cast <Directory *> (_addChild (wszName, vfsNode::type::Directory));
+}
+
+std::wstring
+SK_VirtualFS::vfsNode::getFullPath (void) const
+{
+  size_t len = 0;
+
+  // The root of the VFS is not part of the path
+  for (const vfsNode* pNode = this; pNode != nullptr && pNode->parent != nullptr; pNode = pNode->parent)
+    len += pNode->length + (len != 0 ? 1 : 0);
+
+  std::wstring full_path (len, L'\\');
+
+  for (const vfsNode* pNode = this; pNode != nullptr && pNode->parent != nullptr; pNode = pNode->parent)
+  {
+    len -= pNode->length;
+    std::wmemcpy (full_path.data () + len, pNode->name, pNode->length);
+
+    if (len > 0)
+      len--; // Separator, already in place
+  }
+
+  return full_path;
+}
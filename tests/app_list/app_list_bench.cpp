@@ -0,0 +1,191 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "app_list_library.h"
+
+#include <random>
+
+// The per-frame pass of the library list over 10,000 apps. Every row is checked
+//   for its id, pin, icon worker and filter state, and grouped by category; only
+//     rows in an expanded category are drawn, which needs the full record.
+static constexpr size_t SKIF_Bench_Apps = 10000;
+
+static bool
+SKIF_Bench_IsExpanded (const std::string& category)
+{
+  return category == "Favorites" || category == "Backlog";
+}
+
+// Walking the full records, as the list did before SKIF_AppListView
+static void
+BM_ListPassRecords (benchmark::State& state)
+{
+  apps_t apps =
+    SKIF_Test_Library (SKIF_Bench_Apps);
+
+  for (auto _ : state)
+  {
+    std::string current_category;
+    bool        expanded = false;
+    size_t      drawn    = 0;
+
+    for (auto& app : apps)
+    {
+      if (app.second.id == 0)
+        continue;
+
+      benchmark::DoNotOptimize (app.second.skif.pinned > 50);
+      benchmark::DoNotOptimize (app.second.tex_icon.iWorker == 1);
+
+      if (app.second.filtered)
+        continue;
+
+      std::string category =
+        SKIF_AppList_GetEffectiveCategory (&app.second);
+
+      if (category != current_category)
+      {
+        expanded         = SKIF_Bench_IsExpanded (category);
+        current_category = std::move (category);
+      }
+
+      if (! expanded)
+        continue;
+
+      drawn += app.second.names.normal.size ();
+    }
+
+    benchmark::DoNotOptimize (drawn);
+  }
+
+  state.SetItemsProcessed (state.iterations () * apps.size ());
+}
+
+BENCHMARK (BM_ListPassRecords)->Unit (benchmark::kMicrosecond);
+
+// Walking the hot entries of the view, with the view already built
+static void
+BM_ListPassView (benchmark::State& state)
+{
+  apps_t apps =
+    SKIF_Test_Library (SKIF_Bench_Apps);
+
+  SKIF_AppListView view (&apps);
+
+  for (auto _ : state)
+  {
+    int    current_category = -1;
+    bool   expanded         = false;
+    size_t drawn            = 0;
+
+    for (auto& entry : view.entries ())
+    {
+      if (entry.id == 0)
+        continue;
+
+      benchmark::DoNotOptimize (entry.pinned > 50);
+      benchmark::DoNotOptimize (entry.icon_pending);
+
+      if (entry.filtered)
+        continue;
+
+      if (entry.category != current_category)
+      {
+        expanded         = SKIF_Bench_IsExpanded (view.category (entry.category));
+        current_category = entry.category;
+      }
+
+      if (! expanded)
+        continue;
+
+      drawn += entry.app->second.names.normal.size ();
+    }
+
+    benchmark::DoNotOptimize (drawn);
+  }
+
+  state.SetItemsProcessed (state.iterations () * apps.size ());
+}
+
+BENCHMARK (BM_ListPassView)->Unit (benchmark::kMicrosecond);
+
+// What a frame after a re-sort or filter change pays on top of BM_ListPassView
+static void
+BM_ListViewRebuild (benchmark::State& state)
+{
+  apps_t apps =
+    SKIF_Test_Library (SKIF_Bench_Apps);
+
+  SKIF_AppListView view (&apps);
+
+  for (auto _ : state)
+  {
+    view.invalidate ();
+
+    benchmark::DoNotOptimize (view.entries ().data ());
+  }
+
+  state.SetItemsProcessed (state.iterations () * apps.size ());
+}
+
+BENCHMARK (BM_ListViewRebuild)->Unit (benchmark::kMicrosecond);
+
+// Sorting a shuffled list by used count (args: packed = SKIF_AppList_Sort, or the four stable passes it replaced)
+static void
+BM_Sort (benchmark::State& state)
+{
+  apps_t apps =
+    SKIF_Test_Library (SKIF_Bench_Apps);
+
+  for (auto& app : apps)
+  {
+    app.second.names.all_upper_alnum = app.first;
+    app.second.skif.uses             = static_cast <int> (app.second.id % 13);
+  }
+
+  std::mt19937 rng (0);
+
+  for (auto _ : state)
+  {
+    state.PauseTiming  ();
+    std::shuffle (apps.begin (), apps.end (), rng);
+    state.ResumeTiming ();
+
+    if (state.range (0) != 0)
+      SKIF_AppList_Sort      (&apps, 1);
+    else
+      SKIF_Test_SortFourPass (&apps, 1);
+
+    benchmark::DoNotOptimize (apps.data ());
+  }
+
+  state.SetItemsProcessed (state.iterations () * apps.size ());
+}
+
+BENCHMARK (BM_Sort)
+  ->ArgNames ({ "packed" })
+  ->Arg (0)->Arg (1)
+  ->Unit (benchmark::kMicrosecond);
+
+BENCHMARK_MAIN ();
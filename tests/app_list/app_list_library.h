@@ -0,0 +1,118 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <utility/app_list.h>
+
+#include <algorithm>
+#include <string>
+
+// A library of count apps as SKIF lists them: mostly Steam games, a few pinned,
+//   favorited or categorized, with launch configs and names filled in
+
+using apps_t = SKIF_AppRegistry::apps_t;
+
+static apps_t
+SKIF_Test_Library (size_t count)
+{
+  static const char* categories [] = { "", "", "", "Backlog", "Multiplayer", "Finished" };
+
+  apps_t apps;
+  apps.reserve (count);
+
+  for (size_t i = 0; i < count; i++)
+  {
+    std::string  name = "Synthetic Game " + std::to_string (i);
+    app_record_s record (static_cast <uint32_t> (10 + i * 10));
+
+    record.store                 = (i % 7 == 0) ? app_record_s::Store::Epic : app_record_s::Store::Steam;
+    record.names.normal          = name;
+    record.names.original        = name;
+    record.skif.pinned           = (i % 50 == 0) ? 60 : (i % 25 == 0) ? 1 : -1;
+    record.skif.category         = categories [i % std::size (categories)];
+    record.steam.shared.favorite = (i % 40 == 3) ? 1 : 0;
+    record.filtered              = (i % 5 == 0);
+
+    if (record.store == app_record_s::Store::Epic)
+      record.epic.name_app   = "EpicApp" + std::to_string (i);
+
+    for (int launch = 0; launch < 2; launch++)
+    {
+      app_record_s::launch_config_s config;
+      config.id         = launch;
+      config.executable = L"game" + std::to_wstring (launch) + L".exe";
+
+      record.launch_configs.emplace (launch, std::move (config));
+    }
+
+    apps.emplace_back (std::move (name), std::move (record));
+  }
+
+  return apps;
+}
+
+// The four stable passes SortApps ( ) made before SKIF_AppList_Sort ( ),
+//   kept as the reference for the order the packed key sort has to produce
+static void
+SKIF_Test_SortFourPass (apps_t* apps, int sort)
+{
+  auto _Pinned = [](const app_record_s& app)
+  {
+    return std::max (app.skif.pinned, (app.skif.pinned == -1) ? app.steam.shared.favorite : 0);
+  };
+
+  std::stable_sort (apps->begin (), apps->end (), [](const auto& a, const auto& b)
+  {
+    return a.second.names.all_upper_alnum.compare (b.second.names.all_upper_alnum) < 0;
+  });
+
+  if (sort == 1)
+    std::stable_sort (apps->begin (), apps->end (), [](const auto& a, const auto& b)
+    {
+      return a.second.skif.uses > b.second.skif.uses;
+    });
+
+  else if (sort == 2)
+    std::stable_sort (apps->begin (), apps->end (), [](const auto& a, const auto& b)
+    {
+      return a.second.skif.used.compare (b.second.skif.used) > 0;
+    });
+
+  std::stable_sort (apps->begin (), apps->end (), [&](const auto& a, const auto& b)
+  {
+    return _Pinned (a.second) > _Pinned (b.second);
+  });
+
+  auto it =
+    std::find_if (apps->begin (), apps->end (), [&](const auto& item) { return _Pinned (item.second) == 0; });
+
+  std::stable_sort (it, apps->end (), [](const auto& a, const auto& b)
+  {
+    return a.second.skif.category.compare (b.second.skif.category) < 0;
+  });
+
+  std::stable_partition (it, apps->end (), [](const auto& a)
+  {
+    return ! a.second.skif.category.empty ();
+  });
+}
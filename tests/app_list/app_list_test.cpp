@@ -0,0 +1,271 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include "app_list_library.h"
+
+#include <algorithm>
+#include <random>
+
+TEST (AppRegistry, FindsAppsAfterTheListIsReordered)
+{
+  apps_t           apps = SKIF_Test_Library (200);
+  SKIF_AppRegistry registry (&apps);
+
+  ASSERT_EQ (registry.find (app_record_s::Store::Steam, 20), &apps [1].second);
+
+  std::reverse (apps.begin (), apps.end ());
+
+  // The stale index is noticed on lookup, without an invalidate ( )
+  EXPECT_EQ (registry.find      (app_record_s::Store::Steam, 20),  &apps [198].second);
+  EXPECT_EQ (registry.find      (app_record_s::Store::Steam, 10),   nullptr); // Index 0 is an Epic app
+  EXPECT_EQ (registry.findEpic  ("EpicApp7"),                       &apps [192].second);
+  EXPECT_EQ (registry.findByKey (app_record_s::Store::Steam, "20"), &apps [198].second);
+  EXPECT_EQ (registry.findByKey (app_record_s::Store::Steam, "x"),   nullptr);
+}
+
+TEST (AppListView, MirrorsTheHotFieldsOfTheList)
+{
+  apps_t           apps = SKIF_Test_Library (300);
+  SKIF_AppListView view (&apps);
+
+  auto& entries =
+    view.entries ();
+
+  ASSERT_EQ (entries.size (), apps.size ());
+
+  for (size_t i = 0; i < apps.size (); i++)
+  {
+    const app_record_s& record = apps [i].second;
+
+    EXPECT_EQ (entries [i].app,      &apps [i]);
+    EXPECT_EQ (entries [i].id,       record.id);
+    EXPECT_EQ (entries [i].store,    record.store);
+    EXPECT_EQ (entries [i].pinned,   record.skif.pinned);
+    EXPECT_EQ (entries [i].filtered, record.filtered);
+    EXPECT_EQ (view.category (entries [i].category), SKIF_AppList_GetEffectiveCategory (&record));
+  }
+}
+
+TEST (AppListView, RebuildsWhenTheListChanges)
+{
+  apps_t           apps = SKIF_Test_Library (100);
+  SKIF_AppListView view (&apps);
+
+  EXPECT_FALSE (view.entries () [1].filtered);
+
+  // Filter changes have to be signalled
+  apps [1].second.filtered = true;
+  EXPECT_FALSE (view.entries () [1].filtered);
+
+  view.invalidate ();
+  EXPECT_TRUE  (view.entries () [1].filtered);
+
+  // Re-sorts are picked up through the sort generation
+  std::swap (apps [1], apps [2]);
+  SKIF_AppList_BumpSortGeneration ();
+  EXPECT_EQ    (view.entries () [1].id, apps [1].second.id);
+
+  // As is a list that was replaced
+  apps = SKIF_Test_Library (10);
+  EXPECT_EQ    (view.entries ().size (), 10U);
+}
+
+// The fields the sort looks at, drawn from small pools so that ties are common
+struct SKIF_Test_SortFields {
+  std::string name;
+  int         pinned;
+  int         favorite;
+  std::string category;
+  int         uses;
+  std::string used;
+};
+
+static std::vector <SKIF_Test_SortFields>
+SKIF_Test_RandomFields (std::mt19937& rng, size_t count)
+{
+  static const int   pins       [] = { -1, -1, -1, -1, 0, 0, 1, 50, 51, 99 };
+  static const char* categories [] = { "", "", "", "Backlog", "Multiplayer", "Finished" };
+  static const char* used       [] = { "", "", "1700000000", "1700000100", "1710000000" };
+
+  std::vector <SKIF_Test_SortFields> fields (count);
+
+  for (auto& app : fields)
+  {
+    app.name     = "GAME" + std::to_string (rng () % 40);
+    app.pinned   = pins       [rng () % std::size (pins)];
+    app.favorite = (rng () % 5 == 0) ? 1 : 0;
+    app.category = categories [rng () % std::size (categories)];
+    app.uses     = static_cast <int> (rng () % 6);
+    app.used     = used       [rng () % std::size (used)];
+  }
+
+  return fields;
+}
+
+// Apps are move-only, so comparisons build the same list twice; ids are the position in fields + 1
+static apps_t
+SKIF_Test_BuildList (const std::vector <SKIF_Test_SortFields>& fields, const std::vector <uint32_t>& order)
+{
+  apps_t apps;
+  apps.reserve (order.size ());
+
+  for (uint32_t i : order)
+  {
+    app_record_s record (i + 1);
+
+    record.names.all_upper_alnum = fields [i].name;
+    record.skif.pinned           = fields [i].pinned;
+    record.steam.shared.favorite = fields [i].favorite;
+    record.skif.category         = fields [i].category;
+    record.skif.uses             = fields [i].uses;
+    record.skif.used             = fields [i].used;
+
+    apps.emplace_back (fields [i].name, std::move (record));
+  }
+
+  return apps;
+}
+
+static std::vector <uint32_t>
+SKIF_Test_Order (const apps_t& apps)
+{
+  std::vector <uint32_t> order;
+
+  for (auto& app : apps)
+    order.push_back (app.second.id - 1);
+
+  return order;
+}
+
+static std::vector <uint32_t>
+SKIF_Test_Shuffled (std::mt19937& rng, size_t count)
+{
+  std::vector <uint32_t> order (count);
+
+  for (uint32_t i = 0; i < count; i++)
+    order [i] = i;
+
+  std::shuffle (order.begin (), order.end (), rng);
+
+  return order;
+}
+
+TEST (AppListSort, MatchesTheFourPassSort)
+{
+  std::mt19937 rng (25);
+
+  for (int round = 0; round < 200; round++)
+  {
+    const size_t count =
+      1 + rng () % 400;
+
+    auto fields = SKIF_Test_RandomFields (rng, count);
+    auto order  = SKIF_Test_Shuffled     (rng, count);
+
+    for (int sort = 0; sort <= 2; sort++)
+    {
+      apps_t packed    = SKIF_Test_BuildList (fields, order),
+             reference = SKIF_Test_BuildList (fields, order);
+
+      SKIF_AppList_Sort      (&packed,    sort);
+      SKIF_Test_SortFourPass (&reference, sort);
+
+      ASSERT_EQ (SKIF_Test_Order (packed), SKIF_Test_Order (reference)) << "round=" << round << " sort=" << sort;
+    }
+  }
+}
+
+TEST (AppListSort, KeepsTiesInListOrder)
+{
+  std::mt19937 rng (26);
+
+  // A handful of distinct apps, each listed many times
+  auto fields = SKIF_Test_RandomFields (rng, 8);
+
+  for (size_t i = 8; i < 500; i++)
+    fields.push_back (fields [rng () % 8]);
+
+  for (int sort = 0; sort <= 2; sort++)
+  {
+    auto   order = SKIF_Test_Shuffled  (rng,    fields.size ());
+    apps_t apps  = SKIF_Test_BuildList (fields, order);
+
+    std::vector <size_t> position (fields.size ());
+
+    for (size_t i = 0; i < order.size (); i++)
+      position [order [i]] = i;
+
+    SKIF_AppList_Sort (&apps, sort);
+
+    for (size_t i = 1; i < apps.size (); i++)
+    {
+      const app_record_s& a = apps [i - 1].second;
+      const app_record_s& b = apps [i    ].second;
+
+      ASSERT_FALSE (SKIF_AppList_SortsBefore (b, a, sort)) << "i=" << i << " sort=" << sort;
+
+      if (! SKIF_AppList_SortsBefore (a, b, sort))
+        ASSERT_LT (position [a.id - 1], position [b.id - 1]) << "i=" << i << " sort=" << sort;
+    }
+  }
+}
+
+TEST (AppListSort, RepositionMatchesAFullSort)
+{
+  static const int   pins       [] = { -1, 0, 1, 50, 51, 99 };
+  static const char* categories [] = { "", "Backlog", "Multiplayer", "Finished", "Zzz" };
+
+  std::mt19937 rng (27);
+
+  for (int round = 0; round < 300; round++)
+  {
+    const size_t count =
+      1 + rng () % 200;
+
+    const int sort =
+      static_cast <int> (rng () % 3);
+
+    auto   fields = SKIF_Test_RandomFields (rng,    count);
+    apps_t apps   = SKIF_Test_BuildList    (fields, SKIF_Test_Shuffled (rng, count));
+
+    SKIF_AppList_Sort (&apps, sort);
+
+    // Favorite/unfavorite or a move to another category of a single app
+    app_record_s& changed = apps [rng () % count].second;
+    auto&         field   = fields [changed.id - 1];
+
+    if (rng () % 2 == 0)
+      changed.skif.pinned   = field.pinned   = pins       [rng () % std::size (pins)];
+    else
+      changed.skif.category = field.category = categories [rng () % std::size (categories)];
+
+    apps_t full =
+      SKIF_Test_BuildList (fields, SKIF_Test_Order (apps));
+
+    SKIF_AppList_Reposition (&apps, &changed, sort);
+    SKIF_AppList_Sort       (&full,           sort);
+
+    ASSERT_EQ (SKIF_Test_Order (apps), SKIF_Test_Order (full)) << "round=" << round << " sort=" << sort;
+  }
+}
@@ -0,0 +1,120 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <stores/Steam/apps_ignore.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Appids of a library with a few hundred installed apps and their DLC, as
+//   SKIF_Steam_GetInstalledAppIDs ( ) sees them. About a third are on the list.
+static const std::vector <unsigned int>&
+SKIF_Bench_InstalledApps (void)
+{
+  static std::vector <unsigned int> appids;
+
+  if (appids.empty ())
+  {
+    std::mt19937 rng (1);
+    std::uniform_int_distribution <size_t>       listed (0, std::size (steam_apps_ignorable) - 1);
+    std::uniform_int_distribution <unsigned int> any    (10, 3000000);
+
+    for (int i = 0; i < 1000; i++)
+      appids.push_back ((i % 3 == 0) ? steam_apps_ignorable [listed (rng)] : any (rng));
+  }
+
+  return appids;
+}
+
+// std::find over the unsorted list, which the bitmap replaced
+static void
+BM_IgnorableLinear (benchmark::State& state)
+{
+  auto& appids =
+    SKIF_Bench_InstalledApps ();
+
+  for (auto _ : state)
+  {
+    size_t ignored = 0;
+
+    for (unsigned int appid : appids)
+      ignored += std::find (std::begin (steam_apps_ignorable), std::end (steam_apps_ignorable), appid) != std::end (steam_apps_ignorable);
+
+    benchmark::DoNotOptimize (ignored);
+  }
+
+  state.SetItemsProcessed (state.iterations () * appids.size ());
+}
+
+BENCHMARK (BM_IgnorableLinear)->Unit (benchmark::kMicrosecond);
+
+// Binary search over a sorted copy of the list, the alternative to the bitmap
+static void
+BM_IgnorableSorted (benchmark::State& state)
+{
+  auto& appids =
+    SKIF_Bench_InstalledApps ();
+
+  std::vector <unsigned int> sorted (std::begin (steam_apps_ignorable),
+                                     std::end   (steam_apps_ignorable));
+  std::sort (sorted.begin (), sorted.end ());
+
+  for (auto _ : state)
+  {
+    size_t ignored = 0;
+
+    for (unsigned int appid : appids)
+      ignored += std::binary_search (sorted.begin (), sorted.end (), appid);
+
+    benchmark::DoNotOptimize (ignored);
+  }
+
+  state.SetItemsProcessed (state.iterations () * appids.size ());
+}
+
+BENCHMARK (BM_IgnorableSorted)->Unit (benchmark::kMicrosecond);
+
+static void
+BM_IgnorableBitmap (benchmark::State& state)
+{
+  auto& appids =
+    SKIF_Bench_InstalledApps ();
+
+  for (auto _ : state)
+  {
+    size_t ignored = 0;
+
+    for (unsigned int appid : appids)
+      ignored += SKIF_Steam_isIgnorableApp (appid);
+
+    benchmark::DoNotOptimize (ignored);
+  }
+
+  state.SetItemsProcessed (state.iterations () * appids.size ());
+}
+
+BENCHMARK (BM_IgnorableBitmap)->Unit (benchmark::kMicrosecond);
+
+BENCHMARK_MAIN ();
@@ -0,0 +1,61 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <stores/Steam/apps_ignore.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+TEST (SteamAppsIgnorable, BitmapHoldsExactlyTheList)
+{
+  const std::set <unsigned int> list (std::begin (steam_apps_ignorable),
+                                      std::end   (steam_apps_ignorable));
+
+  size_t bits = 0;
+
+  for (uint64_t word : steam_apps_ignorable_impl::bitmap)
+    bits += static_cast <size_t> (__builtin_popcountll (word));
+
+  EXPECT_EQ (bits, list.size ());
+
+  for (unsigned int appid : list)
+    EXPECT_TRUE (SKIF_Steam_isIgnorableApp (appid)) << appid;
+}
+
+TEST (SteamAppsIgnorable, MatchesLinearSearch)
+{
+  std::mt19937 rng (1);
+  std::uniform_int_distribution <unsigned int> appids (0, steam_apps_ignorable_impl::max_appid () + 1000);
+
+  for (int i = 0; i < 20000; i++)
+  {
+    const unsigned int appid = appids (rng);
+
+    EXPECT_EQ (SKIF_Steam_isIgnorableApp (appid),
+               std::find (std::begin (steam_apps_ignorable), std::end (steam_apps_ignorable), appid) != std::end (steam_apps_ignorable)) << appid;
+  }
+
+  EXPECT_FALSE (SKIF_Steam_isIgnorableApp (UINT32_MAX));
+}
@@ -0,0 +1,131 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "localconfig_generator.h"
+
+#include <stores/Steam/keyvalues.h>
+
+#include <map>
+
+// Inputs are generated once per app count and shared by all benchmarks
+static const std::string&
+SKIF_Bench_LocalConfig (uint32_t apps)
+{
+  static std::map <uint32_t, std::string> inputs;
+
+  auto& input =
+    inputs [apps];
+
+  if (input.empty ())
+  {
+    localconfig_gen::config_s config;
+    config.apps = apps;
+
+    input = localconfig_gen::build (config);
+  }
+
+  return input;
+}
+
+// Hopping from one '"' or '\\' to the next over the whole input, which is the
+//   loop the reader spends its time in (args: vectorised, apps)
+static void
+BM_FindQuote (benchmark::State& state)
+{
+  const std::string& input =
+    SKIF_Bench_LocalConfig (static_cast <uint32_t> (state.range (1)));
+
+  const auto find =
+    (state.range (0) != 0) ? SK_Steam_KeyValues_FindQuote
+                           : SK_Steam_KeyValues_FindQuoteScalar;
+
+  for (auto _ : state)
+  {
+    size_t stops = 0;
+
+    for (size_t pos = 0; pos < input.size (); pos = find (input, pos) + 1)
+      stops++;
+
+    benchmark::DoNotOptimize (stops);
+  }
+
+  state.SetBytesProcessed (state.iterations () * input.size ());
+}
+
+// Real localconfig.vdf files range from a few hundred KiB to several MiB
+BENCHMARK (BM_FindQuote)
+  ->ArgNames ({ "vectorised", "apps" })
+  ->ArgsProduct ({ { 0, 1 }, { 500, 5000 } })
+  ->Unit (benchmark::kMicrosecond);
+
+// Every event of the reader (args: apps)
+static void
+BM_Reader (benchmark::State& state)
+{
+  const std::string& input =
+    SKIF_Bench_LocalConfig (static_cast <uint32_t> (state.range (0)));
+
+  for (auto _ : state)
+  {
+    SK_Steam_KeyValueReader reader (input);
+
+    size_t events = 0;
+
+    while (reader.next () != SK_Steam_KeyValueReader::Event::End)
+      events++;
+
+    benchmark::DoNotOptimize (events);
+  }
+
+  state.SetBytesProcessed (state.iterations () * input.size ());
+}
+
+BENCHMARK (BM_Reader)
+  ->ArgNames ({ "apps" })
+  ->Arg (500)->Arg (5000)
+  ->Unit (benchmark::kMicrosecond);
+
+// The query SKIF_Steam_PreloadUserConfig ( ) runs against localconfig.vdf (args: apps)
+static void
+BM_Query (benchmark::State& state)
+{
+  const std::string& input =
+    SKIF_Bench_LocalConfig (static_cast <uint32_t> (state.range (0)));
+
+  static const SK_Steam_KeyValueQuery
+    localconfig ({ "*/Software/Valve/Steam/Apps/*/LaunchOptions",
+                   "*/apptickets/*" });
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize (localconfig.run (input).size ());
+
+  state.SetBytesProcessed (state.iterations () * input.size ());
+}
+
+BENCHMARK (BM_Query)
+  ->ArgNames ({ "apps" })
+  ->Arg (500)->Arg (5000)
+  ->Unit (benchmark::kMicrosecond);
+
+BENCHMARK_MAIN ();
@@ -0,0 +1,117 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include "localconfig_generator.h"
+
+#include <stores/Steam/keyvalues.h>
+
+#include <cstdlib>
+
+static std::string
+SKIF_Test_Unescape (const std::string& value)
+{
+  std::string out;
+
+  for (size_t i = 0; i < value.size (); i++)
+  {
+    if (value [i] == '\\' && i + 1 < value.size () && value [i + 1] == '"')
+      i++;
+
+    out += value [i];
+  }
+
+  return out;
+}
+
+TEST (KeyValuesReader, VectorisedScanMatchesScalar)
+{
+  localconfig_gen::config_s config;
+  config.apps    = 300;
+  config.friends = 50;
+
+  const std::string input =
+    localconfig_gen::build (config);
+
+  // Every offset, so each alignment and each tail length gets covered
+  for (size_t pos = 0; pos <= input.size (); pos++)
+  {
+    ASSERT_EQ (SK_Steam_KeyValues_FindQuote       (input, pos),
+               SK_Steam_KeyValues_FindQuoteScalar (input, pos)) << "pos=" << pos;
+  }
+}
+
+TEST (KeyValuesReader, HandlesEscapesCommentsAndUnbalancedInput)
+{
+  const std::string input =
+    "// comment \"with quotes\"\n"
+    "\"root\"\n{\n"
+    "  \"escaped\"  \"a\\\"b\\\\c\\nd\"\n"
+    "  unquoted    value [$WIN32]\n"
+    "  \"section\" { \"key\" \"value\" }\n"
+    "}\n}\n"
+    "\"open\" { \"last\" \"value\"";
+
+  SK_Steam_KeyValueTree tree (input);
+
+  EXPECT_EQ (tree.getValue ({ "root", "escaped"  }), "a\"b\\c\nd");
+  EXPECT_EQ (tree.getValue ({ "root", "unquoted" }), "value");
+  EXPECT_EQ (tree.getValue ({ "ROOT", "Section", "KEY" }), "value");
+  EXPECT_EQ (tree.getValue ({ "open", "last" }), "value");
+}
+
+TEST (KeyValuesQuery, FindsLaunchOptionsOfLocalConfig)
+{
+  localconfig_gen::config_s config;
+  config.apps = 600;
+
+  static const SK_Steam_KeyValueQuery
+    localconfig ({ "*/Software/Valve/Steam/Apps/*/LaunchOptions",
+                   "*/system/EnableGameOverlay" });
+
+  size_t launch_options = 0,
+         overlay        = 0;
+
+  for (auto& match : localconfig.run (localconfig_gen::build (config)))
+  {
+    if (match.pattern == 1)
+    {
+      EXPECT_EQ (match.value, "1");
+      overlay++;
+      continue;
+    }
+
+    ASSERT_EQ (match.captures.size (), 2U);
+
+    const uint32_t appid =
+      static_cast <uint32_t> (strtoul (match.captures [1].c_str (), nullptr, 10));
+
+    ASSERT_EQ ((appid - 10) % 30, 0U);
+
+    EXPECT_EQ (match.value, SKIF_Test_Unescape (localconfig_gen::launch_options ((appid - 10) / 10)));
+    launch_options++;
+  }
+
+  EXPECT_EQ (launch_options, (config.apps + 2) / 3);
+  EXPECT_EQ (overlay,        1U);
+}
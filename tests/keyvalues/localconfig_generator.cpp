@@ -0,0 +1,169 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include "localconfig_generator.h"
+
+#include <random>
+
+namespace localconfig_gen
+{
+  // Indented the way Steam writes the file, with a tab between key and value
+  struct kv_writer_s {
+    std::string& out;
+    int          depth = 0;
+
+    void _indent (void)
+    {
+      out.append (depth, '\t');
+    }
+
+    void begin (const std::string& name)
+    {
+      _indent ();
+      out += '"'; out += name; out += "\"\n";
+      _indent ();
+      out += "{\n";
+      depth++;
+    }
+
+    void end (void)
+    {
+      depth--;
+      _indent ();
+      out += "}\n";
+    }
+
+    void str (const std::string& key, const std::string& value)
+    {
+      _indent ();
+      out += '"'; out += key;   out += "\"\t\t";
+      out += '"'; out += value; out += "\"\n";
+    }
+  };
+
+  uint32_t
+  appid (uint32_t index)
+  {
+    return 10 + index * 10;
+  }
+
+  std::string
+  launch_options (uint32_t index)
+  {
+    return "-novid -windowed -w " + std::to_string (1280 + index % 640) + " \\\"+exec autoexec.cfg\\\"";
+  }
+
+  static std::string
+  _hex (std::mt19937& rng, size_t len)
+  {
+    static constexpr char digits [] = "0123456789abcdef";
+
+    std::string hex (len, '0');
+
+    for (auto& c : hex)
+      c = digits [rng () & 0xF];
+
+    return hex;
+  }
+
+  std::string
+  build (const config_s& config)
+  {
+    std::string  out;
+    std::mt19937 rng (config.seed);
+
+    kv_writer_s kv { out };
+
+    kv.begin ("UserLocalConfigStore");
+
+    kv.begin ("friends");
+    for (uint32_t i = 0; i < config.friends; i++)
+    {
+      kv.begin (std::to_string (1000000 + i * 7));
+      kv.str   ("name",   "Friend " + std::to_string (i));
+      kv.str   ("avatar", _hex (rng, 40));
+      kv.begin ("NameHistory");
+      for (uint32_t name = 0; name < 1 + (i % 4); name++)
+        kv.str (std::to_string (name), "Old Name " + std::to_string (name));
+      kv.end   ( );
+      kv.end   ( );
+    }
+    kv.end   ( );
+
+    kv.begin ("Software");
+    kv.begin ("Valve");
+    kv.begin ("Steam");
+    kv.begin ("apps");
+    for (uint32_t i = 0; i < config.apps; i++)
+    {
+      kv.begin (std::to_string (appid (i)));
+      kv.str   ("LastPlayed", std::to_string (1600000000 + rng () % 100000000));
+      kv.str   ("Playtime",   std::to_string (rng () % 100000));
+      if (i % 3 == 0)
+        kv.str ("LaunchOptions", launch_options (i));
+      kv.begin ("cloud");
+      kv.str   ("last_sync_state", "synchronized");
+      kv.str   ("quota_bytes",     std::to_string (rng ()));
+      kv.str   ("quota_files",     std::to_string (rng () % 1000));
+      kv.end   ( );
+      kv.begin ("autocloud");
+      kv.str   ("lastlaunch", std::to_string (1600000000 + rng () % 100000000));
+      kv.str   ("lastexit",   std::to_string (1600000000 + rng () % 100000000));
+      kv.end   ( );
+      if (i % 5 == 0)
+        kv.str ("BadgeData", _hex (rng, 256));
+      kv.end   ( );
+    }
+    kv.end   ( );
+    kv.end   ( );
+    kv.end   ( );
+    kv.end   ( );
+
+    kv.begin ("apptickets");
+    for (uint32_t i = 0; i < config.apps; i += 4)
+      kv.str (std::to_string (appid (i)), _hex (rng, 480));
+    kv.end   ( );
+
+    kv.begin ("system");
+    kv.str   ("EnableGameOverlay", "1");
+    kv.end   ( );
+
+    // JSON stored as escaped strings, the longest values of a real file
+    kv.begin ("WebStorage");
+    for (uint32_t i = 0; i < config.apps / 20 + 1; i++)
+    {
+      std::string json = "{\\\"version\\\":2,\\\"items\\\":[";
+
+      for (int item = 0; item < 16; item++)
+        json += "{\\\"id\\\":\\\"" + _hex (rng, 24) + "\\\",\\\"seen\\\":" + std::to_string (rng () % 2) + "},";
+
+      json += "{}]}";
+
+      kv.str ("cloud-storage-" + std::to_string (i), json);
+    }
+    kv.end   ( );
+
+    kv.end   ( ); // UserLocalConfigStore
+
+    return out;
+  }
+}
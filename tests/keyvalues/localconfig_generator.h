@@ -0,0 +1,48 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Writes a synthetic localconfig.vdf (text KeyValues) in the layout Steam uses,
+//   for the tests and the benchmarks. Besides the per-app entries SKIF queries
+//     (LaunchOptions, apptickets) it carries the bulk of a real file: friends,
+//       cloud and autocloud state, badge data and escaped WebStorage blobs.
+
+namespace localconfig_gen
+{
+  struct config_s {
+    uint32_t apps    = 2000;
+    uint32_t friends = 300;
+    uint32_t seed    = 1;
+  };
+
+  // Appids are unique and deterministic for a given index
+  uint32_t    appid (uint32_t index);
+
+  // Apps with an index divisible by 3 have launch options, see launch_options ( )
+  std::string launch_options (uint32_t index);
+
+  std::string build (const config_s& config);
+}
@@ -0,0 +1,289 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <utility/library_snapshot.h>
+
+using apps_t   = std::vector <std::pair <std::string, app_record_s> >;
+using launch_t = app_record_s::launch_config_s;
+
+static constexpr uint32_t SKIF_Test_Flags = 0x01 | 0x04 | 0x20;
+
+static launch_t
+SKIF_Test_Launch (int id, int id_steam, const wchar_t* executable)
+{
+  launch_t launch;
+  launch.id                = id;
+  launch.id_steam          = id_steam;
+  launch.type              = (id == 0) ? launch_t::Type::Default : launch_t::Type::Option1;
+  launch.cpu_type          = app_record_s::CPUType::x64;
+  launch.platforms         = app_record_s::Platform::Windows;
+  launch.executable        = executable;
+  launch.executable_path   = std::wstring (LR"(C:\Games\Test\)") + executable;
+  launch.install_dir       = LR"(C:\Games\Test)";
+  launch.description       = L"Play " + std::to_wstring (id);
+  launch.launch_options    = L"-novid -high";
+  launch.working_dir       = L"bin";
+  launch.requires_dlc      = (id == 1) ? "1234" : "";
+  launch.valid             = 1;
+
+  return launch;
+}
+
+// A processed Steam app, with its custom launch config merged in the way processing does it
+static std::pair <std::string, app_record_s>
+SKIF_Test_SteamApp (void)
+{
+  app_record_s record (570);
+
+  record.store                     = app_record_s::Store::Steam;
+  record.store_utf8                = "Steam";
+  record.install_dir               = LR"(C:\Games\Steam\steamapps\common\dota 2 beta)";
+  record.names.original            = "Dota 2";
+  record.names.clean               = "Dota 2";
+  record.names.normal              = "dota 2";
+  record.names.all_upper           = "DOTA 2";
+  record.skif.name                 = "Dota";
+  record.skif.cpu_type             = 2;
+  record.skif.instant_play         = 1;
+  record.skif.auto_stop            = 2;
+  record.skif.uses                 = 42;
+  record.skif.used                 = "1700000000";
+  record.skif.used_formatted       = "2023-11-14";
+  record.skif.category             = "MOBA";
+  record.skif.pinned               = 60;
+  record.steam.local.launch_option = "-console";
+  record.steam.shared.favorite     = 1;
+  record.steam.shared.tags         = { "Favorites", "Competitive", "Ünïcode" };
+  record.steam.branch              = "beta";
+  record.specialk.profile_dir      = L"Dota 2";
+  record.specialk.profile_dir_utf8 = "Dota 2";
+
+  auto steam_default = SKIF_Test_Launch (0, 0, L"dota2.exe");
+  auto steam_option  = SKIF_Test_Launch (1, 3, L"dota2_vulkan.exe");
+  steam_option.branches = { "beta", "staging" };
+
+  record.launch_configs.emplace (0, std::move (steam_default));
+  record.launch_configs.emplace (1, std::move (steam_option));
+
+  auto custom = SKIF_Test_Launch (0, 0, L"dota2_tools.exe");
+  custom.custom_user = true;
+
+  launch_t merged = custom;
+  merged.id       = static_cast <int> (record.launch_configs.size ());
+  merged.id_steam = -1;
+
+  record.launch_configs       .emplace (merged.id, std::move (merged));
+  record.launch_configs_custom.emplace (0,         std::move (custom));
+
+  return { "Dota 2", std::move (record) };
+}
+
+static std::pair <std::string, app_record_s>
+SKIF_Test_EpicApp (void)
+{
+  app_record_s record (0x2F4A1C);
+
+  record.store                  = app_record_s::Store::Epic;
+  record.store_utf8             = "Epic";
+  record.install_dir            = LR"(D:\Epic\Fortnite)";
+  record.names.original         = "Fortnite";
+  record.epic.catalog_namespace = "fn";
+  record.epic.catalog_item_id   = "4fe75bbc5a674f4f9b356b5c90567da5";
+  record.epic.name_app          = "Fortnite";
+  record.epic.name_display      = "Fortnite";
+  record.skif.hidden            = 1;
+
+  record.launch_configs.emplace (0, SKIF_Test_Launch (0, 0, L"FortniteLauncher.exe"));
+
+  return { "Fortnite", std::move (record) };
+}
+
+static apps_t
+SKIF_Test_Library (void)
+{
+  apps_t apps;
+
+  apps.push_back (SKIF_Test_SteamApp ());
+  apps.push_back (SKIF_Test_EpicApp  ());
+
+  // Filtered out apps are left out of the snapshot
+  apps.emplace_back ("Uninstalled", app_record_s (0));
+
+  return apps;
+}
+
+static void
+SKIF_Test_ExpectEqual (const std::map <int, launch_t>& expected, const std::map <int, launch_t>& actual)
+{
+  ASSERT_EQ (expected.size (), actual.size ());
+
+  for (auto& [key, launch] : expected)
+  {
+    ASSERT_TRUE (actual.count (key)) << key;
+
+    const launch_t& read = actual.at (key);
+
+    EXPECT_EQ (read.id,                 launch.id);
+    EXPECT_EQ (read.id_steam,           launch.id_steam);
+    EXPECT_EQ (read.type,               launch.type);
+    EXPECT_EQ (read.cpu_type,           launch.cpu_type);
+    EXPECT_EQ (read.platforms,          launch.platforms);
+    EXPECT_EQ (read.executable,         launch.executable);
+    EXPECT_EQ (read.executable_path,    launch.executable_path);
+    EXPECT_EQ (read.install_dir,        launch.install_dir);
+    EXPECT_EQ (read.Xbox_ApplicationId, launch.Xbox_ApplicationId);
+    EXPECT_EQ (read.executable_helper,  launch.executable_helper);
+    EXPECT_EQ (read.description,        launch.description);
+    EXPECT_EQ (read.launch_options,     launch.launch_options);
+    EXPECT_EQ (read.working_dir,        launch.working_dir);
+    EXPECT_EQ (read.requires_dlc,       launch.requires_dlc);
+    EXPECT_EQ (read.branches,           launch.branches);
+    EXPECT_EQ (read.valid,              launch.valid);
+    EXPECT_EQ (read.custom_skif,        launch.custom_skif);
+    EXPECT_EQ (read.custom_user,        launch.custom_user);
+  }
+}
+
+static void
+SKIF_Test_ExpectEqual (const std::pair <std::string, app_record_s>& expected, const std::pair <std::string, app_record_s>& actual)
+{
+  const app_record_s& record = expected.second;
+  const app_record_s& read   = actual  .second;
+
+  EXPECT_EQ (actual.first,                    expected.first);
+  EXPECT_EQ (read.id,                         record.id);
+  EXPECT_EQ (read.store,                      record.store);
+  EXPECT_EQ (read.store_utf8,                 record.store_utf8);
+  EXPECT_EQ (read.install_dir,                record.install_dir);
+  EXPECT_EQ (read.names.original,             record.names.original);
+  EXPECT_EQ (read.names.clean,                record.names.clean);
+  EXPECT_EQ (read.names.normal,               record.names.normal);
+  EXPECT_EQ (read.names.all_upper,            record.names.all_upper);
+  EXPECT_EQ (read.skif.name,                  record.skif.name);
+  EXPECT_EQ (read.skif.cpu_type,              record.skif.cpu_type);
+  EXPECT_EQ (read.skif.instant_play,          record.skif.instant_play);
+  EXPECT_EQ (read.skif.auto_stop,             record.skif.auto_stop);
+  EXPECT_EQ (read.skif.uses,                  record.skif.uses);
+  EXPECT_EQ (read.skif.used,                  record.skif.used);
+  EXPECT_EQ (read.skif.used_formatted,        record.skif.used_formatted);
+  EXPECT_EQ (read.skif.category,              record.skif.category);
+  EXPECT_EQ (read.skif.hidden,                record.skif.hidden);
+  EXPECT_EQ (read.skif.pinned,                record.skif.pinned);
+  EXPECT_EQ (read.steam.local.launch_option,  record.steam.local.launch_option);
+  EXPECT_EQ (read.steam.shared.hidden,        record.steam.shared.hidden);
+  EXPECT_EQ (read.steam.shared.favorite,      record.steam.shared.favorite);
+  EXPECT_EQ (read.steam.shared.tags,          record.steam.shared.tags);
+  EXPECT_EQ (read.steam.branch,               record.steam.branch);
+  EXPECT_EQ (read.epic.catalog_namespace,     record.epic.catalog_namespace);
+  EXPECT_EQ (read.epic.catalog_item_id,       record.epic.catalog_item_id);
+  EXPECT_EQ (read.epic.name_app,              record.epic.name_app);
+  EXPECT_EQ (read.epic.name_display,          record.epic.name_display);
+  EXPECT_EQ (read.specialk.profile_dir,       record.specialk.profile_dir);
+  EXPECT_EQ (read.specialk.profile_dir_utf8,  record.specialk.profile_dir_utf8);
+
+  // Only installed apps make it into a snapshot
+  EXPECT_TRUE (read._status.installed);
+
+  SKIF_Test_ExpectEqual (record.launch_configs,        read.launch_configs);
+  SKIF_Test_ExpectEqual (record.launch_configs_custom, read.launch_configs_custom);
+}
+
+TEST (LibrarySnapshot, RoundTripsEveryPersistedField)
+{
+  const apps_t                  apps       = SKIF_Test_Library ();
+  const std::set <std::string>  apptickets = { "570", "730" };
+
+  SKIF_BinaryWriter out;
+  SKIF_LibrarySnapshot_Serialize (out, SKIF_Test_Flags, &apps, &apptickets);
+
+  apps_t                 read_apps;
+  std::set <std::string> read_tickets;
+
+  SKIF_BinaryReader in { out.buf.data (), out.buf.data () + out.buf.size () };
+
+  ASSERT_TRUE (SKIF_LibrarySnapshot_Deserialize (in, SKIF_Test_Flags, &read_apps, &read_tickets));
+
+  ASSERT_EQ (read_apps.size (), 2U);
+
+  SKIF_Test_ExpectEqual (apps [0], read_apps [0]);
+  SKIF_Test_ExpectEqual (apps [1], read_apps [1]);
+
+  EXPECT_EQ (read_tickets, apptickets);
+  EXPECT_EQ (read_apps [0].second.ImGuiLabelID, "###1-570-selectable");
+}
+
+TEST (LibrarySnapshot, SurvivesTheFileSystem)
+{
+  const apps_t                  apps       = SKIF_Test_Library ();
+  const std::set <std::string>  apptickets = { "570" };
+
+  const std::wstring path =
+    std::filesystem::temp_directory_path ().wstring () + L"/skif_library_snapshot_test.cache";
+
+  SKIF_BinaryWriter out;
+  SKIF_LibrarySnapshot_Serialize (out, SKIF_Test_Flags, &apps, &apptickets);
+
+  ASSERT_TRUE (out.save (path));
+
+  std::vector <BYTE> buffer;
+  ASSERT_TRUE (SKIF_BinaryReader::load (path, buffer));
+
+  std::filesystem::remove (std::filesystem::path (path));
+
+  EXPECT_EQ (buffer, out.buf);
+
+  apps_t                 read_apps;
+  std::set <std::string> read_tickets;
+
+  SKIF_BinaryReader in { buffer.data (), buffer.data () + buffer.size () };
+
+  ASSERT_TRUE (SKIF_LibrarySnapshot_Deserialize (in, SKIF_Test_Flags, &read_apps, &read_tickets));
+  ASSERT_EQ   (read_apps.size (), 2U);
+
+  SKIF_Test_ExpectEqual (apps [0], read_apps [0]);
+}
+
+TEST (LibrarySnapshot, RejectsOtherSettingsAndTruncatedData)
+{
+  const apps_t                  apps       = SKIF_Test_Library ();
+  const std::set <std::string>  apptickets = { "570" };
+
+  SKIF_BinaryWriter out;
+  SKIF_LibrarySnapshot_Serialize (out, SKIF_Test_Flags, &apps, &apptickets);
+
+  apps_t                 read_apps;
+  std::set <std::string> read_tickets = { "untouched" };
+
+  SKIF_BinaryReader other { out.buf.data (), out.buf.data () + out.buf.size () };
+  EXPECT_FALSE (SKIF_LibrarySnapshot_Deserialize (other, SKIF_Test_Flags ^ 0x20, &read_apps, &read_tickets));
+
+  for (size_t len : { size_t (0), size_t (12), out.buf.size () / 2, out.buf.size () - 1 })
+  {
+    SKIF_BinaryReader truncated { out.buf.data (), out.buf.data () + len };
+    EXPECT_FALSE (SKIF_LibrarySnapshot_Deserialize (truncated, SKIF_Test_Flags, &read_apps, &read_tickets)) << len;
+  }
+
+  EXPECT_TRUE (read_apps.empty ());
+  EXPECT_EQ   (read_tickets, (std::set <std::string> { "untouched" }));
+}
@@ -0,0 +1,135 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <stores/Steam/manifest_set.h>
+
+using Action = SK_Steam_ManifestSet::change_s::Action;
+
+static SK_Steam_ManifestSet
+SKIF_Test_ScannedSet (void)
+{
+  SK_Steam_ManifestSet set;
+
+  set.scan ({ L"appmanifest_10.acf", L"appmanifest_20.acf", L"libraryfolder.vdf", L"appmanifest_.acf" });
+
+  return set;
+}
+
+TEST (ManifestSet, ScanKeepsOnlyManifests)
+{
+  auto set =
+    SKIF_Test_ScannedSet ();
+
+  EXPECT_FALSE (set.rescan);
+  EXPECT_EQ    (set.files, (std::set <std::wstring> { L"appmanifest_10.acf", L"appmanifest_20.acf" }));
+}
+
+TEST (ManifestSet, AddedManifestsAreInsertedOnce)
+{
+  auto set =
+    SKIF_Test_ScannedSet ();
+
+  EXPECT_TRUE  (set.apply ({ { Action::Added, L"appmanifest_30.acf" } }));
+  EXPECT_FALSE (set.apply ({ { Action::Added, L"appmanifest_30.acf" } }));
+
+  // Steam writes manifests through a temporary file, which is then renamed
+  EXPECT_FALSE (set.apply ({ { Action::Added, L"appmanifest_40.acf.tmp" },
+                             { Action::Added, L"downloading"            } }));
+
+  EXPECT_TRUE  (set.apply ({ { Action::Added, L"APPMANIFEST_40.ACF"     } }));
+  EXPECT_FALSE (set.apply ({ { Action::Added, L"appmanifest_40.acf"     } }));
+
+  EXPECT_EQ    (set.files, (std::set <std::wstring> { L"appmanifest_10.acf", L"appmanifest_20.acf",
+                                                      L"appmanifest_30.acf", L"appmanifest_40.acf" }));
+  EXPECT_FALSE (set.rescan);
+}
+
+TEST (ManifestSet, CaseVariantsAreOneManifest)
+{
+  auto set =
+    SKIF_Test_ScannedSet ();
+
+  // NTFS is case-insensitive, a listing and a later event may disagree on case
+  EXPECT_FALSE (set.apply ({ { Action::Added,   L"AppManifest_10.ACF" } }));
+  EXPECT_TRUE  (set.apply ({ { Action::Removed, L"APPMANIFEST_20.acf" } }));
+
+  set.scan ({ L"AppManifest_70.acf", L"appmanifest_70.ACF" });
+
+  EXPECT_EQ    (set.files, (std::set <std::wstring> { L"appmanifest_70.acf" }));
+}
+
+TEST (ManifestSet, AppIdsParseInAnyCase)
+{
+  EXPECT_EQ (SK_Steam_ManifestSet::appidOf (L"appmanifest_40.acf"),     40U);
+  EXPECT_EQ (SK_Steam_ManifestSet::appidOf (L"APPMANIFEST_40.ACF"),     40U);
+  EXPECT_EQ (SK_Steam_ManifestSet::appidOf (L"appmanifest_4294967295.acf"), 4294967295U);
+
+  EXPECT_EQ (SK_Steam_ManifestSet::appidOf (L"appmanifest_4294967296.acf"), 0U);
+  EXPECT_EQ (SK_Steam_ManifestSet::appidOf (L"appmanifest_4x.acf"),     0U);
+  EXPECT_EQ (SK_Steam_ManifestSet::appidOf (L"appmanifest_40.acf.tmp"), 0U);
+  EXPECT_EQ (SK_Steam_ManifestSet::appidOf (L"libraryfolder.vdf"),      0U);
+}
+
+TEST (ManifestSet, RemovedManifestsAreErased)
+{
+  auto set =
+    SKIF_Test_ScannedSet ();
+
+  EXPECT_TRUE  (set.apply ({ { Action::Removed, L"appmanifest_10.acf" } }));
+  EXPECT_FALSE (set.apply ({ { Action::Removed, L"appmanifest_10.acf" } }));
+  EXPECT_FALSE (set.apply ({ { Action::Removed, L"appmanifest_99.acf" } }));
+
+  EXPECT_EQ    (set.files, (std::set <std::wstring> { L"appmanifest_20.acf" }));
+}
+
+TEST (ManifestSet, EventsApplyInOrder)
+{
+  auto set =
+    SKIF_Test_ScannedSet ();
+
+  // An update shows up as a removal and an addition of the same name
+  EXPECT_TRUE  (set.apply ({ { Action::Removed, L"appmanifest_20.acf" },
+                             { Action::Added,   L"appmanifest_20.acf" },
+                             { Action::Added,   L"appmanifest_50.acf" },
+                             { Action::Removed, L"appmanifest_50.acf" } }));
+
+  EXPECT_EQ    (set.files, (std::set <std::wstring> { L"appmanifest_10.acf", L"appmanifest_20.acf" }));
+}
+
+TEST (ManifestSet, OverflowRequestsRescan)
+{
+  auto set =
+    SKIF_Test_ScannedSet ();
+
+  // Events around the overflow still apply, the rescan picks up whatever was lost
+  EXPECT_TRUE  (set.apply ({ { Action::Added,   L"appmanifest_30.acf" },
+                             { Action::Overflow                       } }));
+  EXPECT_TRUE  (set.rescan);
+  EXPECT_TRUE  (set.files.count (L"appmanifest_30.acf"));
+
+  set.scan ({ L"appmanifest_10.acf", L"appmanifest_30.acf", L"appmanifest_60.acf" });
+
+  EXPECT_FALSE (set.rescan);
+  EXPECT_EQ    (set.files, (std::set <std::wstring> { L"appmanifest_10.acf", L"appmanifest_30.acf", L"appmanifest_60.acf" }));
+}
@@ -0,0 +1,354 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+// Minimal stand-in for the parts of the Windows SDK that the platform-neutral
+//   sources of SKIF use, so tests/ builds with any C++20 compiler. Files and
+//     file mappings are implemented on top of POSIX; everything else is types.
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <cwchar>
+#include <string>
+#include <string_view>
+#include <map>
+#include <mutex>
+
+#include <fcntl.h>
+#include <strings.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define interface struct
+
+#define __int32 int
+#define __int64 long long
+
+#define WINAPI
+#define UNREFERENCED_PARAMETER(P) (void)(P)
+
+typedef int32_t        __time32_t;
+
+typedef uint8_t        BYTE;
+typedef uint16_t       WORD;
+typedef uint32_t       DWORD;
+typedef int32_t        BOOL;
+typedef int32_t        LONG;
+typedef int64_t        LONGLONG;
+typedef uint64_t       ULONGLONG;
+typedef uint32_t       UINT;
+typedef uintptr_t      UINT_PTR;
+typedef size_t         SIZE_T;
+typedef wchar_t        WCHAR;
+typedef const wchar_t* LPCWSTR;
+typedef void*          HANDLE;
+typedef void*          HWND;
+typedef void*          LPVOID;
+
+#ifndef TRUE
+#define TRUE  1
+#define FALSE 0
+#endif
+
+#define MAX_PATH 260
+
+union LARGE_INTEGER {
+  struct {
+    DWORD LowPart;
+    LONG  HighPart;
+  };
+  LONGLONG QuadPart;
+};
+
+struct FILETIME {
+  DWORD dwLowDateTime;
+  DWORD dwHighDateTime;
+};
+
+struct GUID {
+  uint32_t Data1;
+  uint16_t Data2;
+  uint16_t Data3;
+  uint8_t  Data4 [8];
+};
+
+typedef GUID        IID;
+typedef const IID&  REFIID;
+
+struct SYSTEM_INFO {
+  DWORD dwPageSize;
+  DWORD dwAllocationGranularity;
+};
+
+#define INVALID_HANDLE_VALUE      ((HANDLE)(intptr_t)-1)
+#define INFINITE                  0xFFFFFFFF
+#define WAIT_OBJECT_0             0x0
+#define GENERIC_READ              0x80000000
+#define FILE_SHARE_READ           0x1
+#define FILE_SHARE_WRITE          0x2
+#define FILE_SHARE_DELETE         0x4
+#define OPEN_EXISTING             3
+#define FILE_ATTRIBUTE_NORMAL     0x80
+#define FILE_FLAG_SEQUENTIAL_SCAN 0x08000000
+#define PAGE_READONLY             0x02
+#define FILE_MAP_READ             0x04
+#define FILE_BEGIN                0
+#define MOVEFILE_REPLACE_EXISTING 0x1
+
+inline int _stricmp (const char*    lhs, const char*    rhs) { return strcasecmp (lhs, rhs); }
+inline int _wcsicmp (const wchar_t* lhs, const wchar_t* rhs) { return wcscasecmp (lhs, rhs); }
+
+// Paths used by the tests are plain ASCII, anything else is replaced
+inline std::string
+SKIF_Shim_Narrow (std::wstring_view wide)
+{
+  std::string narrow;
+              narrow.reserve (wide.size ());
+
+  for (wchar_t ch : wide)
+    narrow.push_back ((ch < 0x80) ? static_cast <char> (ch) : '?');
+
+  return narrow;
+}
+
+inline DWORD& SKIF_Shim_LastError (void) { static thread_local DWORD error = 0; return error; }
+
+inline DWORD GetLastError (void) { return SKIF_Shim_LastError ( ); }
+
+// Files and mappings are both represented by a file descriptor
+struct SKIF_Shim_Handle {
+  int      fd   = -1;
+  uint64_t size =  0;
+};
+
+// Number of files and mappings currently open, for tests of what is held onto
+inline std::atomic <int>& SKIF_Shim_OpenHandles (void) { static std::atomic <int> handles = 0; return handles; }
+
+inline HANDLE
+CreateFileW (LPCWSTR path, DWORD, DWORD, void*, DWORD, DWORD, HANDLE)
+{
+  int fd =
+    open (SKIF_Shim_Narrow (path).c_str (), O_RDONLY);
+
+  if (fd < 0)
+  {
+    SKIF_Shim_LastError ( ) = errno;
+    return INVALID_HANDLE_VALUE;
+  }
+
+  SKIF_Shim_OpenHandles ( )++;
+
+  return new SKIF_Shim_Handle { fd };
+}
+
+inline BOOL
+GetFileSizeEx (HANDLE hFile, LARGE_INTEGER* pSize)
+{
+  struct stat st = { };
+
+  if (fstat (static_cast <SKIF_Shim_Handle *> (hFile)->fd, &st) != 0)
+    return FALSE;
+
+  pSize->QuadPart = st.st_size;
+
+  return TRUE;
+}
+
+// Only the last write time, in 100 ns units since the Unix epoch rather than 1601
+inline BOOL
+GetFileTime (HANDLE hFile, FILETIME*, FILETIME*, FILETIME* pLastWrite)
+{
+  struct stat st = { };
+
+  if (fstat (static_cast <SKIF_Shim_Handle *> (hFile)->fd, &st) != 0)
+    return FALSE;
+
+  const uint64_t ticks =
+    static_cast <uint64_t> (st.st_mtim.tv_sec) * 10000000ULL + st.st_mtim.tv_nsec / 100;
+
+  pLastWrite->dwLowDateTime  = static_cast <DWORD> (ticks & 0xFFFFFFFF);
+  pLastWrite->dwHighDateTime = static_cast <DWORD> (ticks >> 32);
+
+  return TRUE;
+}
+
+inline LONG
+CompareFileTime (const FILETIME* lhs, const FILETIME* rhs)
+{
+  const uint64_t a = (static_cast <uint64_t> (lhs->dwHighDateTime) << 32) | lhs->dwLowDateTime;
+  const uint64_t b = (static_cast <uint64_t> (rhs->dwHighDateTime) << 32) | rhs->dwLowDateTime;
+
+  return (a < b) ? -1 : (a > b) ? 1 : 0;
+}
+
+inline HANDLE
+CreateFileMappingW (HANDLE hFile, void*, DWORD, DWORD, DWORD, LPCWSTR)
+{
+  LARGE_INTEGER size = { };
+
+  if (! GetFileSizeEx (hFile, &size))
+    return nullptr;
+
+  SKIF_Shim_OpenHandles ( )++;
+
+  return new SKIF_Shim_Handle { dup (static_cast <SKIF_Shim_Handle *> (hFile)->fd), static_cast <uint64_t> (size.QuadPart) };
+}
+
+inline BOOL
+CloseHandle (HANDLE handle)
+{
+  if (handle == nullptr || handle == INVALID_HANDLE_VALUE)
+    return FALSE;
+
+  auto pHandle =
+    static_cast <SKIF_Shim_Handle *> (handle);
+
+  close  (pHandle->fd);
+  delete  pHandle;
+
+  SKIF_Shim_OpenHandles ( )--;
+
+  return TRUE;
+}
+
+// munmap needs the length of a view, which UnmapViewOfFile is not given
+inline std::map <void*, size_t>& SKIF_Shim_Views     (void) { static std::map <void*, size_t> views; return views; }
+inline std::mutex&               SKIF_Shim_ViewsLock (void) { static std::mutex               lock;  return lock;  }
+
+inline LPVOID
+MapViewOfFile (HANDLE hMapping, DWORD, DWORD dwOffsetHigh, DWORD dwOffsetLow, SIZE_T len)
+{
+  auto pMapping =
+    static_cast <SKIF_Shim_Handle *> (hMapping);
+
+  const uint64_t offset =
+    (static_cast <uint64_t> (dwOffsetHigh) << 32) | dwOffsetLow;
+
+  if (len == 0)
+      len = static_cast <SIZE_T> (pMapping->size - offset);
+
+  void* pView =
+    mmap (nullptr, len, PROT_READ, MAP_PRIVATE, pMapping->fd, static_cast <off_t> (offset));
+
+  if (pView == MAP_FAILED)
+  {
+    SKIF_Shim_LastError ( ) = errno;
+    return nullptr;
+  }
+
+  std::lock_guard <std::mutex> lock (SKIF_Shim_ViewsLock ( ));
+  SKIF_Shim_Views ( ) [pView] = len;
+
+  return pView;
+}
+
+inline BOOL
+UnmapViewOfFile (const void* pView)
+{
+  std::lock_guard <std::mutex> lock (SKIF_Shim_ViewsLock ( ));
+
+  auto it =
+    SKIF_Shim_Views ( ).find (const_cast <void *> (pView));
+
+  if (it == SKIF_Shim_Views ( ).end ())
+    return FALSE;
+
+  munmap (it->first, it->second);
+  SKIF_Shim_Views ( ).erase (it);
+
+  return TRUE;
+}
+
+inline BOOL
+SetFilePointerEx (HANDLE hFile, LARGE_INTEGER liPos, LARGE_INTEGER* pNewPos, DWORD)
+{
+  off_t pos =
+    lseek (static_cast <SKIF_Shim_Handle *> (hFile)->fd, static_cast <off_t> (liPos.QuadPart), SEEK_SET);
+
+  if (pNewPos != nullptr)
+      pNewPos->QuadPart = pos;
+
+  return pos >= 0;
+}
+
+inline BOOL
+ReadFile (HANDLE hFile, LPVOID pBuffer, DWORD dwLen, DWORD* pdwRead, void*)
+{
+  DWORD total = 0;
+
+  while (total < dwLen)
+  {
+    ssize_t got =
+      read (static_cast <SKIF_Shim_Handle *> (hFile)->fd, static_cast <BYTE *> (pBuffer) + total, dwLen - total);
+
+    if (got <= 0)
+      break;
+
+    total += static_cast <DWORD> (got);
+  }
+
+  if (pdwRead != nullptr)
+     *pdwRead  = total;
+
+  return TRUE;
+}
+
+inline void
+GetSystemInfo (SYSTEM_INFO* pInfo)
+{
+  pInfo->dwPageSize              = static_cast <DWORD> (sysconf (_SC_PAGESIZE));
+  pInfo->dwAllocationGranularity = 64 * 1024;
+}
+
+inline int
+_wfopen_s (FILE** pFile, const wchar_t* path, const wchar_t* mode)
+{
+  std::string narrow_mode;
+
+  // 'S' (optimize for sequential access) is MSVC-specific
+  for (char ch : SKIF_Shim_Narrow (mode))
+    if (ch != 'S')
+      narrow_mode.push_back (ch);
+
+  *pFile =
+    fopen (SKIF_Shim_Narrow (path).c_str (), narrow_mode.c_str ());
+
+  return (*pFile != nullptr) ? 0 : errno;
+}
+
+inline BOOL
+MoveFileExW (LPCWSTR from, LPCWSTR to, DWORD)
+{
+  return rename (SKIF_Shim_Narrow (from).c_str (), SKIF_Shim_Narrow (to).c_str ()) == 0;
+}
+
+inline BOOL
+DeleteFileW (LPCWSTR path)
+{
+  return unlink (SKIF_Shim_Narrow (path).c_str ()) == 0;
+}
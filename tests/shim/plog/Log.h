@@ -0,0 +1,42 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+// Swallows everything logged through the PLOG_* macros
+
+namespace plog
+{
+  struct null_record_s
+  {
+    template <class _T>
+    null_record_s& operator<< (const _T&) { return *this; }
+  };
+}
+
+#define PLOG_NONE    plog::null_record_s { }
+#define PLOG_FATAL   plog::null_record_s { }
+#define PLOG_ERROR   plog::null_record_s { }
+#define PLOG_WARNING plog::null_record_s { }
+#define PLOG_INFO    plog::null_record_s { }
+#define PLOG_DEBUG   plog::null_record_s { }
+#define PLOG_VERBOSE plog::null_record_s { }
@@ -0,0 +1,78 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+// Shadows include/utility/sk_utility.h with the few string helpers that the
+//   headers built by tests/ depend on
+
+#include <Windows.h>
+#include <atlbase.h>
+#include <plog/Log.h>
+
+#include <string>
+#include <cstdarg>
+#include <algorithm>
+#include <vector>
+
+// Only round-trips ASCII, which is all the tests feed through these
+inline std::string
+SK_WideCharToUTF8 (const std::wstring& in)
+{
+  return SKIF_Shim_Narrow (in);
+}
+
+inline std::wstring
+SK_UTF8ToWideChar (const std::string& in)
+{
+  return std::wstring (in.begin (), in.end ());
+}
+
+inline std::string
+SK_FormatString (char const* const _Format, ...)
+{
+  va_list   _ArgList;
+  va_start (_ArgList, _Format);
+  int len = vsnprintf (nullptr, 0, _Format, _ArgList);
+  va_end   (_ArgList);
+
+  std::string out (static_cast <size_t> (std::max (len, 0)), '\0');
+
+  va_start (_ArgList, _Format);
+  vsnprintf (out.data (), out.size () + 1, _Format, _ArgList);
+  va_end   (_ArgList);
+
+  return out;
+}
+
+inline std::wstring
+SK_FormatStringW (wchar_t const* const _Format, ...)
+{
+  std::vector <wchar_t> buf (1024);
+
+  va_list   _ArgList;
+  va_start (_ArgList, _Format);
+  int len = vswprintf (buf.data (), buf.size (), _Format, _ArgList);
+  va_end   (_ArgList);
+
+  return std::wstring (buf.data (), static_cast <size_t> (std::max (len, 0)));
+}
@@ -0,0 +1,52 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+// Shadows include/utility/utility.h, only the few helpers that code built by
+//   tests/ calls are provided, on top of the shim of sk_utility.h
+
+#include <utility/sk_utility.h>
+
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+
+// Same contract as SKIF's: the returned buffer is reused by the next call on the thread
+inline char*
+SKIF_Util_FormatStringRaw (char const* const _Format, ...)
+{
+  static thread_local std::string s_data;
+
+  va_list   _ArgList;
+  va_start (_ArgList, _Format);
+  int len = vsnprintf (nullptr, 0, _Format, _ArgList);
+  va_end   (_ArgList);
+
+  s_data.assign (static_cast <size_t> (len > 0 ? len : 0), '\0');
+
+  va_start (_ArgList, _Format);
+  vsnprintf (s_data.data (), s_data.size () + 1, _Format, _ArgList);
+  va_end   (_ArgList);
+
+  return s_data.data ();
+}
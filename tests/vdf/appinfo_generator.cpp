@@ -0,0 +1,405 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include "appinfo_generator.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string_view>
+#include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <unistd.h>
+
+namespace appinfo_gen
+{
+  enum _TokenOp : uint8_t {
+    SectionBegin = 0x0,
+    String       = 0x1,
+    Int32        = 0x2,
+    Int64        = 0x7,
+    SectionEnd   = 0x8
+  };
+
+  // Key names, which end up in the string table for 0x29
+  struct string_pool_s {
+    std::vector <std::string>                   strings;
+    std::unordered_map <std::string, uint32_t>  index;
+    size_t                                      filler = 0; // First name that SKIF does not know
+
+    uint32_t intern (std::string_view name)
+    {
+      auto it =
+        index.find (std::string (name));
+
+      if (it != index.end ())
+        return it->second;
+
+      strings.emplace_back (name);
+
+      return index [strings.back ()] =
+        static_cast <uint32_t> (strings.size () - 1);
+    }
+  };
+
+  class kv_writer_s
+  {
+  public:
+    kv_writer_s (std::vector <uint8_t>& out, string_pool_s& pool, bool table) :
+                                   _out (out),         _pool (pool), _table (table) { }
+
+    void begin (std::string_view name)                        { _op (SectionBegin, name); }
+    void end   (void)                                         { _out.push_back (SectionEnd); }
+    void str   (std::string_view name, std::string_view val)  { _op (String, name); _out.insert (_out.end (), val.begin (), val.end ()); _out.push_back ('\0'); }
+    void i32   (std::string_view name, int32_t          val)  { _op (Int32,  name); _raw (&val, sizeof (val)); }
+    void i64   (std::string_view name, int64_t          val)  { _op (Int64,  name); _raw (&val, sizeof (val)); }
+
+  private:
+    void _raw (const void* src, size_t len)
+    {
+      _out.insert (_out.end (), (const uint8_t *)src, (const uint8_t *)src + len);
+    }
+
+    void _op (_TokenOp op, std::string_view name)
+    {
+      _out.push_back (op);
+
+      if (_table)
+      {
+        uint32_t idx =
+          _pool.intern (name);
+
+        _raw (&idx, sizeof (idx));
+      }
+
+      else
+      {
+        _out.insert (_out.end (), name.begin (), name.end ());
+        _out.push_back ('\0');
+      }
+    }
+
+    std::vector <uint8_t>& _out;
+    string_pool_s&         _pool;
+    bool                   _table;
+  };
+
+  uint32_t
+  appid (uint32_t index)
+  {
+    return 10 + index * 10;
+  }
+
+  // Nested sections SKIF has no interest in, like the depots and localization of real apps
+  static void
+  _padding (kv_writer_s& kv, const config_s& config, std::mt19937& rng, const string_pool_s& pool, uint32_t depth, size_t& budget)
+  {
+    // Only unknown names, so that no padding is mistaken for a section SKIF reads
+    std::uniform_int_distribution <size_t> pick (pool.filler, pool.strings.size () - 1);
+
+    const std::string& name = pool.strings [pick (rng)];
+
+    kv.begin (name);
+
+    for (int i = 0; i < 4 && budget > 0; i++)
+    {
+      const std::string& key = pool.strings [pick (rng)];
+
+      switch (rng () % 3)
+      {
+        case 0:
+          kv.str (key, "padding_value_" + std::to_string (rng () % 100000));
+          break;
+        case 1:
+          kv.i32 (key, static_cast <int32_t> (rng ()));
+          break;
+        default:
+          kv.i64 (key, static_cast <int64_t> (rng ()) << 16);
+          break;
+      }
+
+      budget -= std::min <size_t> (budget, 24);
+    }
+
+    if (depth > 1)
+    {
+      for (int i = 0; i < 2 && budget > 0; i++)
+        _padding (kv, config, rng, pool, depth - 1, budget);
+    }
+
+    kv.end ();
+  }
+
+  static void
+  _app (std::vector <uint8_t>& out, const config_s& config, string_pool_s& pool, uint32_t id)
+  {
+    std::mt19937 rng (config.seed ^ (id * 2654435761u));
+
+    kv_writer_s kv (out, pool, config.version >= 0x29);
+
+    const size_t start = out.size ();
+    const std::string name = "Synthetic App " + std::to_string (id);
+
+    kv.begin ("appinfo");
+    kv.i32   ("appid", static_cast <int32_t> (id));
+
+    kv.begin ("common");
+    kv.str   ("name",   name);
+    kv.str   ("type",   "Game");
+    kv.str   ("oslist", "windows");
+    kv.str   ("osarch", (id % 3 == 0) ? "32" : "64");
+    kv.str   ("icon",   "0123456789abcdef0123456789abcdef01234567");
+    kv.begin ("library_assets_full");
+    kv.begin ("library_capsule");
+    kv.begin ("image");
+    kv.str   ("english", "library_capsule.jpg");
+    kv.end   ( );
+    kv.end   ( );
+    kv.end   ( );
+    kv.end   ( );
+
+    kv.begin ("extended");
+    kv.str   ("developer",  "Synthetic Developer");
+    kv.str   ("publisher",  "Synthetic Publisher");
+    kv.str   ("homepage",   "https://example.com/");
+    if (id % 4 == 0)
+      kv.str ("vacmodulefilename", "sourceinit.dat");
+    kv.end   ( );
+
+    kv.begin ("config");
+    kv.str   ("installdir", name);
+    kv.begin ("launch");
+    for (uint32_t launch = 0; launch < 1 + (id % 3); launch++)
+    {
+      kv.begin (std::to_string (launch));
+      kv.str   ("executable",  "bin/game" + std::to_string (launch) + ".exe");
+      kv.str   ("arguments",   (launch == 0) ? "" : "-mode " + std::to_string (launch));
+      kv.str   ("description", "Launch option " + std::to_string (launch));
+      kv.str   ("type",        (launch == 0) ? "default" : "option1");
+      kv.str   ("workingdir",  "bin");
+      kv.begin ("config");
+      kv.str   ("oslist",  "windows");
+      kv.str   ("osarch",  "64");
+      if (launch == 2)
+        kv.str ("betakey", "beta");
+      kv.end   ( );
+      kv.end   ( );
+    }
+    kv.end   ( );
+    kv.end   ( );
+
+    kv.begin ("ufs");
+    kv.i32   ("quota",    100000000);
+    kv.i32   ("maxnumfiles", 100);
+    kv.begin ("savefiles");
+    kv.begin ("0");
+    kv.str   ("root",    "WinMyDocuments");
+    kv.str   ("path",    "My Games/" + name);
+    kv.str   ("pattern", "*");
+    kv.begin ("platforms");
+    kv.str   ("1",       "Windows");
+    kv.end   ( );
+    kv.end   ( );
+    kv.end   ( );
+    kv.begin ("rootoverrides");
+    kv.begin ("0");
+    kv.str   ("root",       "WinMyDocuments");
+    kv.str   ("os",         "MacOS");
+    kv.str   ("useinstead", "MacAppSupport");
+    kv.str   ("addpath",    "Saves");
+    kv.end   ( );
+    kv.end   ( );
+    kv.end   ( );
+
+    kv.begin ("depots");
+    kv.begin (std::to_string (id + 1));
+    kv.begin ("manifests");
+    kv.begin ("public");
+    kv.str   ("gid",  std::to_string (rng ()));
+    kv.i64   ("size", static_cast <int64_t> (rng ()) * 1024);
+    kv.end   ( );
+    kv.end   ( );
+    kv.end   ( );
+    kv.begin ("branches");
+    kv.begin ("public");
+    kv.str   ("buildid",     std::to_string (1000 + id));
+    kv.str   ("timeupdated", "1700000000");
+    kv.end   ( );
+    kv.begin ("beta");
+    kv.str   ("buildid",     std::to_string (2000 + id));
+    kv.str   ("description", "Public beta");
+    kv.str   ("pwdrequired", "0");
+    kv.str   ("timeupdated", "1710000000");
+    kv.end   ( );
+    kv.end   ( );
+    kv.end   ( );
+
+    // The bulk of a real app lies in sections SKIF skips, like localization
+    size_t used   = out.size () - start;
+    size_t budget = (config.blob > used) ? config.blob - used : 0;
+
+    while (budget > 0)
+      _padding (kv, config, rng, pool, std::max <uint32_t> (config.depth, 1), budget);
+
+    kv.end ( ); // appinfo
+    kv.end ( ); // Root
+  }
+
+  template <typename _T>
+  static void
+  _pod (std::vector <uint8_t>& out, _T val)
+  {
+    out.insert (out.end (), (const uint8_t *)&val, (const uint8_t *)&val + sizeof (_T));
+  }
+
+  template <typename _T>
+  static void
+  _patch (std::vector <uint8_t>& out, size_t pos, _T val)
+  {
+    memcpy (out.data () + pos, &val, sizeof (_T));
+  }
+
+  file_s
+  build (const config_s& config)
+  {
+    file_s        file = { };
+    string_pool_s pool;
+
+    // Names SKIF looks for first, then filler up to the requested pool size
+    for (const char* name : { "appinfo", "appid", "common", "name", "type", "oslist", "osarch", "icon",
+                              "library_assets_full", "library_capsule", "image", "english",
+                              "extended", "developer", "publisher", "homepage", "vacmodulefilename",
+                              "config", "installdir", "launch", "executable", "arguments", "description",
+                              "workingdir", "betakey", "ufs", "quota", "maxnumfiles", "savefiles", "root",
+                              "path", "pattern", "platforms", "rootoverrides", "os", "useinstead", "addpath",
+                              "depots", "manifests", "public", "gid", "size", "branches", "buildid",
+                              "timeupdated", "beta", "pwdrequired" })
+      pool.intern (name);
+
+    pool.filler = pool.strings.size ();
+
+    for (uint32_t i = 0; pool.strings.size () < std::max <size_t> (config.strings, pool.filler + 16); i++)
+      pool.intern ("key_" + std::to_string (i));
+
+    auto& out = file.data;
+
+    _pod <uint32_t> (out, 0x07564400 | (config.version & 0xFF));
+    _pod <uint32_t> (out, 1); // Universe
+
+    const size_t table_pos = out.size ();
+
+    if (config.version >= 0x29)
+      _pod <uint64_t> (out, 0);
+
+    // Steam does not keep the file sorted by appid, neither does this
+    std::vector <uint32_t> order (config.apps);
+
+    for (uint32_t i = 0; i < config.apps; i++)
+      order [i] = appid (i);
+
+    std::shuffle (order.begin (), order.end (), std::mt19937 (config.seed));
+
+    for (uint32_t id : order)
+    {
+      _pod <uint32_t> (out, id);
+
+      const size_t size_pos = out.size ();
+      _pod <uint32_t> (out, 0);
+
+      _pod <uint32_t> (out, 2);                       // state
+      _pod <int32_t>  (out, 1700000000);              // last_update
+      _pod <uint64_t> (out, 0);                       // access_token
+
+      for (int i = 0; i < 20; i++)                    // sha1sum
+        out.push_back (static_cast <uint8_t> ((id * 31 + i) ^ config.seed));
+
+      _pod <uint32_t> (out, id ^ config.seed);        // change_num
+
+      if (config.version >= 0x28)
+        out.insert (out.end (), 20, 0xAB);            // sha1_sec
+
+      const size_t kv_start = out.size ();
+
+      _app (out, config, pool, id);
+
+      file.kv_bytes += out.size () - kv_start;
+      file.appids.push_back (id);
+
+      _patch <uint32_t> (out, size_pos, static_cast <uint32_t> (out.size () - size_pos - sizeof (uint32_t)));
+    }
+
+    _pod <uint32_t> (out, 0); // _LastSteamApp
+
+    if (config.version >= 0x29)
+    {
+      _patch <uint64_t> (out, table_pos, static_cast <uint64_t> (out.size ()));
+      _pod   <uint32_t> (out, static_cast <uint32_t> (pool.strings.size ()));
+
+      for (auto& str : pool.strings)
+        out.insert (out.end (), str.c_str (), str.c_str () + str.size () + 1);
+    }
+
+    return file;
+  }
+
+  static bool
+  _save (const std::vector <uint8_t>& data, const std::string& path)
+  {
+    FILE* fOut =
+      fopen (path.c_str (), "wb");
+
+    if (fOut == nullptr)
+      return false;
+
+    bool written =
+      fwrite (data.data (), data.size (), 1, fOut) == 1;
+
+    return (fclose (fOut) == 0) && written;
+  }
+
+  bool
+  write (const config_s& config, const std::string& path)
+  {
+    return _save (build (config).data, path);
+  }
+
+  temp_file_s::temp_file_s (const config_s& config)
+  {
+    static std::atomic <uint32_t> counter = 0;
+
+    path  = ( std::filesystem::temp_directory_path () /
+              ( "skif_appinfo_" + std::to_string (getpid ()) + "_" +
+                                  std::to_string (counter++) + ".vdf" ) ).string ();
+    wpath = std::wstring (path.begin (), path.end ());
+    file  = build (config);
+
+    _save (file.data, path);
+  }
+
+  temp_file_s::~temp_file_s (void)
+  {
+    std::error_code ec;
+    std::filesystem::remove (path, ec);
+  }
+}
@@ -0,0 +1,69 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Writes synthetic appinfo.vdf files in the layout Steam uses, for the tests,
+//   the fuzzer and the benchmarks. Every app carries the sections SKIF reads
+//     (common, extended, config.launch, ufs, depots.branches) and is padded
+//       up to the requested size with nested sections that SKIF ignores.
+
+namespace appinfo_gen
+{
+  struct config_s {
+    uint32_t version = 0x29; // 0x27, 0x28 or 0x29
+    uint32_t apps    = 1000;
+    uint32_t depth   = 4;    // Nesting depth of the padding sections
+    uint32_t strings = 2000; // Distinct key names, which is the string table size for 0x29
+    uint32_t blob    = 4096; // Approximate size of the KeyValues of each app, in bytes
+    uint32_t seed    = 1;
+  };
+
+  struct file_s {
+    std::vector <uint8_t>  data;
+    std::vector <uint32_t> appids;     // In file order, which is not sorted
+    uint64_t               kv_bytes;   // Total size of the KeyValues of all apps
+  };
+
+  // Appids are unique and deterministic for a given index
+  uint32_t appid (uint32_t index);
+
+  file_s   build (const config_s& config);
+  bool     write (const config_s& config, const std::string& path);
+
+  // Generated file in the temp directory, removed again on destruction
+  struct temp_file_s {
+    temp_file_s (const config_s& config);
+   ~temp_file_s (void);
+
+    temp_file_s            (const temp_file_s&) = delete;
+    temp_file_s& operator= (const temp_file_s&) = delete;
+
+    std:: string path;
+    std::wstring wpath;
+    file_s       file;
+  };
+}
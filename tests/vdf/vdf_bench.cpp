@@ -0,0 +1,278 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "appinfo_generator.h"
+
+#include <stores/Steam/vdf.h>
+
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <random>
+#include <tuple>
+
+using LoadMode  = skValveDataFile::LoadMode;
+using appinfo_s = skValveDataFile::appinfo_s;
+using section_s = appinfo_s::section_s;
+
+// Files are generated once per configuration and shared by all benchmarks
+static appinfo_gen::temp_file_s&
+SKIF_Bench_File (uint32_t version, uint32_t apps = 10000, uint32_t blob = 4096)
+{
+  static std::map <std::tuple <uint32_t, uint32_t, uint32_t>,
+                   std::unique_ptr <appinfo_gen::temp_file_s>> files;
+
+  auto& file =
+    files [{ version, apps, blob }];
+
+  if (file == nullptr)
+  {
+    appinfo_gen::config_s config;
+    config.version = version;
+    config.apps    = apps;
+    config.blob    = blob;
+
+    file = std::make_unique <appinfo_gen::temp_file_s> (config);
+  }
+
+  return *file;
+}
+
+static std::vector <appinfo_s::section_desc_s>
+SKIF_Bench_Sections (skValveDataFile& vdf)
+{
+  std::vector <appinfo_s::section_desc_s> sections;
+
+  // Held open for as long as the reader is around
+  if (! vdf.acquireFile ( ))
+    return sections;
+
+  for (appinfo_s* pApp = vdf.root; pApp != nullptr; pApp = pApp->getNextApp ())
+  {
+    appinfo_s::section_desc_s desc { };
+    desc.blob = pApp->getRootSection (&desc.size);
+
+    sections.push_back (desc);
+  }
+
+  return sections;
+}
+
+// Anonymous (heap) part of the resident set in bytes, or 0 where it cannot be read.
+//   Pages of a read-only file mapping are left out, as they are clean and shared
+//     with the file cache rather than private to the process
+static double
+SKIF_Bench_ResidentAnon (void)
+{
+  double resident = 0.0;
+
+#ifdef __linux__
+  if (FILE* status = fopen ("/proc/self/status", "r"))
+  {
+    char line [256];
+
+    while (fgets (line, sizeof (line), status) != nullptr)
+    {
+      long kib = 0;
+
+      if (sscanf (line, "RssAnon: %ld kB", &kib) == 1)
+      {
+        resident = static_cast <double> (kib) * 1024.0;
+        break;
+      }
+    }
+
+    fclose (status);
+  }
+#endif
+
+  return resident;
+}
+
+// Opening the file and building the index of it (args: version, LoadMode)
+static void
+BM_Load (benchmark::State& state)
+{
+  auto& temp =
+    SKIF_Bench_File (static_cast <uint32_t> (state.range (0)));
+
+  for (auto _ : state)
+  {
+    skValveDataFile vdf (temp.wpath, static_cast <LoadMode> (state.range (1)));
+
+    benchmark::DoNotOptimize (vdf.index.data ());
+  }
+
+  state.SetBytesProcessed (state.iterations () * temp.file.data.size ());
+  state.SetItemsProcessed (state.iterations () * temp.file.appids.size ());
+}
+
+BENCHMARK (BM_Load)
+  ->ArgNames ({ "version", "mode" })
+  ->ArgsProduct ({ { 0x27, 0x28, 0x29 }, { (int)LoadMode::Buffered, (int)LoadMode::Mapped, (int)LoadMode::Windowed } })
+  ->Unit (benchmark::kMillisecond);
+
+// Opening a file the size of the appinfo.vdf of a large account (~200 MiB) (args: LoadMode).
+//   resident_delta is how much the private resident set grew while the reader was alive,
+//     which is where the buffered copy of the file shows up and the mapped view does not
+static void
+BM_LoadLarge (benchmark::State& state)
+{
+  auto& temp =
+    SKIF_Bench_File (0x29, 32768, 8192);
+
+  double resident_delta = 0.0;
+
+  for (auto _ : state)
+  {
+    const double
+      resident_before = SKIF_Bench_ResidentAnon ();
+
+    skValveDataFile vdf (temp.wpath, static_cast <LoadMode> (state.range (0)));
+
+    benchmark::DoNotOptimize (vdf.index.data ());
+
+    resident_delta =
+      std::max (resident_delta, SKIF_Bench_ResidentAnon () - resident_before);
+  }
+
+  state.counters ["resident_delta"] =
+    benchmark::Counter (resident_delta, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+
+  state.SetBytesProcessed (state.iterations () * temp.file.data.size ());
+}
+
+BENCHMARK (BM_LoadLarge)
+  ->ArgNames ({ "mode" })
+  ->Arg ((int)LoadMode::Buffered)->Arg ((int)LoadMode::Mapped)
+  ->Unit (benchmark::kMillisecond);
+
+// Looking up every app through the index, in random order (args: version)
+static void
+BM_FindApp (benchmark::State& state)
+{
+  auto& temp =
+    SKIF_Bench_File (static_cast <uint32_t> (state.range (0)));
+
+  skValveDataFile vdf (temp.wpath, LoadMode::Mapped);
+
+  std::vector <uint32_t> appids = temp.file.appids;
+  std::shuffle (appids.begin (), appids.end (), std::mt19937 (1));
+
+  for (auto _ : state)
+  {
+    for (uint32_t appid : appids)
+      benchmark::DoNotOptimize (vdf.findApp (appid));
+  }
+
+  state.SetItemsProcessed (state.iterations () * appids.size ());
+}
+
+BENCHMARK (BM_FindApp)
+  ->ArgNames ({ "version" })
+  ->Arg (0x27)->Arg (0x28)->Arg (0x29);
+
+// Parsing the KeyValues of every app, reported as MB/s of KeyValues (args: version)
+static void
+BM_ParseApp (benchmark::State& state)
+{
+  auto& temp =
+    SKIF_Bench_File (static_cast <uint32_t> (state.range (0)));
+
+  skValveDataFile vdf (temp.wpath, LoadMode::Mapped);
+
+  auto sections =
+    SKIF_Bench_Sections (vdf);
+
+  section_s section;
+
+  for (auto _ : state)
+  {
+    for (auto& desc : sections)
+    {
+      section.parse (desc, vdf);
+
+      benchmark::DoNotOptimize (section.tape.size ());
+    }
+  }
+
+  state.SetBytesProcessed (state.iterations () * temp.file.kv_bytes);
+  state.SetItemsProcessed (state.iterations () * sections.size ());
+}
+
+BENCHMARK (BM_ParseApp)
+  ->ArgNames ({ "version" })
+  ->Arg (0x27)->Arg (0x28)->Arg (0x29)
+  ->Unit (benchmark::kMillisecond);
+
+// Selective against full parses of every app (args: selective, blob size in bytes).
+//   tokenised is the KeyValues bytes per app that made it onto the tape, and
+//     time_per_app the wall time of one parse
+static void
+BM_ParseSelective (benchmark::State& state)
+{
+  auto& temp =
+    SKIF_Bench_File (0x29, 2000, static_cast <uint32_t> (state.range (1)));
+
+  skValveDataFile vdf (temp.wpath, LoadMode::Mapped);
+
+  auto sections =
+    SKIF_Bench_Sections (vdf);
+
+  section_s section;
+  section.selective = (state.range (0) != 0);
+
+  size_t skipped = 0;
+
+  for (auto _ : state)
+  {
+    skipped = 0;
+
+    for (auto& desc : sections)
+    {
+      section.parse (desc, vdf);
+
+      skipped += section.bytes_skipped;
+
+      benchmark::DoNotOptimize (section.tape.size ());
+    }
+  }
+
+  const double apps =
+    static_cast <double> (sections.size ());
+
+  state.counters ["tokenised"] =
+    benchmark::Counter (static_cast <double> (temp.file.kv_bytes - skipped) / apps, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+  state.counters ["time_per_app"] =
+    benchmark::Counter (apps, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+
+  state.SetBytesProcessed (state.iterations () * temp.file.kv_bytes);
+}
+
+BENCHMARK (BM_ParseSelective)
+  ->ArgNames ({ "selective", "blob" })
+  ->ArgsProduct ({ { 0, 1 }, { 4096, 65536 } })
+  ->Unit (benchmark::kMillisecond);
+
+BENCHMARK_MAIN ();
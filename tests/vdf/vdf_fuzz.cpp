@@ -0,0 +1,258 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include "appinfo_generator.h"
+
+#include <stores/Steam/vdf.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Fuzzes skValveDataFile::appinfo_s::section_s::parse ( ). The first byte of an
+//   input selects the file version (and thus how names are encoded) as well as
+//     selective or full parsing, the rest is the KeyValues blob of a single app.
+
+using appinfo_s = skValveDataFile::appinfo_s;
+using section_s = appinfo_s::section_s;
+
+static const uint32_t SKIF_Fuzz_Versions [] = { 0x27, 0x28, 0x29 };
+
+// Version 0x29 names refer to the string table, which comes from this file
+static appinfo_gen::config_s
+SKIF_Fuzz_Config (uint32_t version)
+{
+  appinfo_gen::config_s config;
+  config.version = version;
+  config.apps    = 8;
+  config.strings = 256;
+  config.blob    = 1024;
+
+  return config;
+}
+
+static skValveDataFile&
+SKIF_Fuzz_Reader (void)
+{
+  static std::unique_ptr <skValveDataFile> vdf;
+
+  if (vdf == nullptr)
+  {
+    appinfo_gen::temp_file_s temp (SKIF_Fuzz_Config (0x29));
+
+    vdf = std::make_unique <skValveDataFile> (temp.wpath, skValveDataFile::LoadMode::Buffered);
+  }
+
+  return *vdf;
+}
+
+extern "C" int
+LLVMFuzzerTestOneInput (const uint8_t* data, size_t size)
+{
+  if (size < 1)
+    return 0;
+
+  skValveDataFile& vdf =
+    SKIF_Fuzz_Reader ( );
+
+  skValveDataFile::vdf_version =
+    SKIF_Fuzz_Versions [(data [0] & 0x7F) % std::size (SKIF_Fuzz_Versions)];
+
+  // A copy of exactly the input size, so that reading past it gets caught
+  std::vector <uint8_t> blob (data + 1, data + size);
+
+  appinfo_s::section_desc_s desc { blob.data (), blob.size () };
+
+  static section_s                     section;
+  static std::vector <section_s::key_s> keys;
+
+  section.selective = (data [0] & 0x80) == 0;
+  section.parse (desc, vdf);
+
+  // Walk the tape the way _extractAppInfo ( ) does
+  size_t sink = 0;
+
+  for (uint32_t row = 0; row < section.tape.size (); row++)
+  {
+    if (section.tape.op [row] != section_s::SectionBegin)
+      continue;
+
+    section.keysOf (row, keys);
+
+    sink += section.entryOf (row, section_s::ConfigLaunch);
+
+    for (auto& key : keys)
+    {
+      int64_t value = 0;
+
+      if (key.op == section_s::String)
+        sink += strlen ((const char *)key.value);
+      else if (key.op == section_s::Int32)
+        memcpy (&value, key.value, sizeof (int32_t));
+      else if (key.op == section_s::Int64)
+        memcpy (&value, key.value, sizeof (int64_t));
+
+      sink += static_cast <size_t> (value);
+
+      if (key.name != nullptr)
+        sink += strlen (key.name);
+    }
+  }
+
+  static volatile size_t
+         s_sink;
+         s_sink = sink;
+
+  return 0;
+}
+
+#ifdef SKIF_FUZZ_REPLAY
+// The KeyValues of every app in generated files of each version, prefixed with the selector byte
+static std::vector <std::vector <uint8_t>>
+SKIF_Fuzz_Seeds (void)
+{
+  std::vector <std::vector <uint8_t>> seeds;
+
+  for (uint8_t selector = 0; selector < std::size (SKIF_Fuzz_Versions); selector++)
+  {
+    appinfo_gen::temp_file_s temp (SKIF_Fuzz_Config (SKIF_Fuzz_Versions [selector]));
+    skValveDataFile          vdf  (temp.wpath, skValveDataFile::LoadMode::Buffered);
+
+    for (appinfo_s* pApp = vdf.root; pApp != nullptr; pApp = pApp->getNextApp ())
+    {
+      size_t size = 0;
+      auto   blob = static_cast <const uint8_t *> (pApp->getRootSection (&size));
+
+      std::vector <uint8_t> seed { selector };
+      seed.insert (seed.end (), blob, blob + size);
+
+      seeds.push_back (seed);
+    }
+  }
+
+  return seeds;
+}
+
+static void
+SKIF_Fuzz_Run (const std::vector <uint8_t>& input)
+{
+  LLVMFuzzerTestOneInput (input.data (), input.size ());
+}
+
+// vdf_fuzz [--corpus <dir>] [--mutations <n>] [files or directories to replay...]
+int
+main (int argc, char** argv)
+{
+  std::vector <std::filesystem::path> inputs;
+  std::filesystem::path               corpus;
+  unsigned long                       mutations = 20000;
+
+  for (int i = 1; i < argc; i++)
+  {
+         if (strcmp (argv [i], "--corpus")    == 0 && i + 1 < argc) corpus    = argv [++i];
+    else if (strcmp (argv [i], "--mutations") == 0 && i + 1 < argc) mutations = strtoul (argv [++i], nullptr, 0);
+    else                                                            inputs.emplace_back (argv [i]);
+  }
+
+  // Replay given inputs, e.g. crashes found by libFuzzer elsewhere
+  if (! inputs.empty ())
+  {
+    for (auto& input : inputs)
+    {
+      std::vector <std::filesystem::path> files;
+
+      if (std::filesystem::is_directory (input))
+      {
+        for (auto& entry : std::filesystem::directory_iterator (input))
+          files.push_back (entry.path ());
+      }
+      else
+        files.push_back (input);
+
+      for (auto& file : files)
+      {
+        std::ifstream in (file, std::ios::binary);
+
+        SKIF_Fuzz_Run ({ std::istreambuf_iterator <char> (in), { } });
+      }
+
+      printf ("Replayed %zu inputs from %s\n", files.size (), input.string ().c_str ());
+    }
+
+    return 0;
+  }
+
+  auto seeds = SKIF_Fuzz_Seeds ( );
+
+  // Seed corpus for a libFuzzer build of this target
+  if (! corpus.empty ())
+  {
+    std::filesystem::create_directories (corpus);
+
+    for (size_t i = 0; i < seeds.size (); i++)
+    {
+      std::ofstream out (corpus / ("seed_" + std::to_string (i)), std::ios::binary);
+      out.write ((const char *)seeds [i].data (), seeds [i].size ());
+    }
+
+    printf ("Wrote %zu seeds to %s\n", seeds.size (), corpus.string ().c_str ());
+
+    return 0;
+  }
+
+  for (auto& seed : seeds)
+    SKIF_Fuzz_Run (seed);
+
+  // Deterministic mutations: flipped, overwritten, inserted and removed bytes plus truncation
+  std::mt19937 rng (0x534B4946);
+
+  for (unsigned long i = 0; i < mutations; i++)
+  {
+    std::vector <uint8_t> input = seeds [rng () % seeds.size ()];
+
+    for (uint32_t edits = 1 + rng () % 8; edits > 0 && input.size () > 1; edits--)
+    {
+      size_t pos = 1 + rng () % (input.size () - 1);
+
+      switch (rng () % 5)
+      {
+        case 0: input [pos] ^= static_cast <uint8_t> (1 << (rng () % 8));                         break;
+        case 1: input [pos]  = static_cast <uint8_t> (rng ());                                    break;
+        case 2: input.insert (input.begin () + pos, static_cast <uint8_t> (rng () % 9));          break;
+        case 3: input.erase  (input.begin () + pos);                                              break;
+        case 4: input.resize (pos);                                                               break;
+      }
+    }
+
+    SKIF_Fuzz_Run (input);
+  }
+
+  printf ("Ran %zu seeds and %lu mutations of them\n", seeds.size (), mutations);
+
+  return 0;
+}
+#endif
@@ -0,0 +1,73 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include "appinfo_generator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// vdf_generate <output> [--version 0x29] [--apps 1000] [--depth 4] [--strings 2000] [--blob 4096] [--seed 1]
+int
+main (int argc, char** argv)
+{
+  appinfo_gen::config_s config;
+
+  std::string path;
+
+  for (int i = 1; i < argc; i++)
+  {
+    auto _Value = [&](void) -> uint32_t
+    {
+      if (i + 1 >= argc)
+      {
+        fprintf (stderr, "Missing value for %s\n", argv [i]);
+        exit (2);
+      }
+
+      return static_cast <uint32_t> (strtoul (argv [++i], nullptr, 0));
+    };
+
+         if (strcmp (argv [i], "--version") == 0) config.version = _Value ( );
+    else if (strcmp (argv [i], "--apps")    == 0) config.apps    = _Value ( );
+    else if (strcmp (argv [i], "--depth")   == 0) config.depth   = _Value ( );
+    else if (strcmp (argv [i], "--strings") == 0) config.strings = _Value ( );
+    else if (strcmp (argv [i], "--blob")    == 0) config.blob    = _Value ( );
+    else if (strcmp (argv [i], "--seed")    == 0) config.seed    = _Value ( );
+    else                                          path           = argv [i];
+  }
+
+  if (path.empty () || config.version < 0x27 || config.version > 0x29)
+  {
+    fprintf (stderr, "Usage: %s <output> [--version 0x27|0x28|0x29] [--apps n] [--depth n] [--strings n] [--blob bytes] [--seed n]\n", argv [0]);
+    return 2;
+  }
+
+  if (! appinfo_gen::write (config, path))
+  {
+    fprintf (stderr, "Failed to write %s\n", path.c_str ());
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,277 @@
+//
+// Copyright 2024 Andon "Kaldaien" Coleman
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include "appinfo_generator.h"
+
+#include <stores/Steam/vdf.h>
+
+#include <cstring>
+#include <tuple>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+using LoadMode  = skValveDataFile::LoadMode;
+using appinfo_s = skValveDataFile::appinfo_s;
+using section_s = appinfo_s::section_s;
+
+static std::vector <appinfo_s *>
+SKIF_Test_Apps (skValveDataFile& vdf)
+{
+  std::vector <appinfo_s *> apps;
+
+  for (appinfo_s* pApp = vdf.root; pApp != nullptr; pApp = pApp->getNextApp ())
+    apps.push_back (pApp);
+
+  return apps;
+}
+
+static size_t
+SKIF_Test_CountRows (const section_s& section, section_s::_PathId path, section_s::_KeyId key)
+{
+  size_t count = 0;
+
+  for (size_t row = 0; row < section.tape.size (); row++)
+  {
+    if (section.tape.path [row] == path && section.tape.key [row] == key && section.tape.op [row] != section_s::SectionBegin)
+      count++;
+  }
+
+  return count;
+}
+
+class AppInfoReader : public ::testing::TestWithParam <std::tuple <uint32_t, LoadMode>> { };
+
+TEST_P (AppInfoReader, IndexesEveryApp)
+{
+  auto [version, mode] = GetParam ();
+
+  appinfo_gen::config_s config;
+  config.version = version;
+  config.apps    = 500;
+  config.blob    = 2048;
+
+  appinfo_gen::temp_file_s temp (config);
+  skValveDataFile          vdf  (temp.wpath, mode);
+
+  EXPECT_EQ (skValveDataFile::vdf_version, version);
+  ASSERT_EQ (vdf.index.size (), config.apps);
+
+  for (uint32_t appid : temp.file.appids)
+  {
+    auto pEntry = vdf.findApp (appid);
+
+    ASSERT_NE (pEntry, nullptr) << appid;
+    EXPECT_EQ (pEntry->change_num, appid ^ config.seed);
+  }
+
+  EXPECT_EQ (vdf.findApp (5),                                 nullptr);
+  EXPECT_EQ (vdf.findApp (appinfo_gen::appid (config.apps)), nullptr);
+
+  // Only a buffered copy of the file stays in memory once it has been indexed
+  EXPECT_EQ (vdf.root == nullptr, mode != LoadMode::Buffered);
+
+  ASSERT_TRUE (vdf.acquireFile ( ));
+  EXPECT_EQ    (vdf.root == nullptr, mode == LoadMode::Windowed);
+  vdf.releaseFile ( );
+}
+
+TEST_P (AppInfoReader, OnlyHoldsTheFileWhileReading)
+{
+  auto [version, mode] = GetParam ();
+
+  appinfo_gen::config_s config;
+  config.version = version;
+  config.apps    = 100;
+
+  appinfo_gen::temp_file_s temp (config);
+
+  const int handles = SKIF_Shim_OpenHandles ( );
+
+  skValveDataFile vdf (temp.wpath, mode);
+
+  ASSERT_EQ (vdf.index.size (), config.apps);
+  EXPECT_EQ (SKIF_Shim_OpenHandles ( ), handles);
+  EXPECT_TRUE (SKIF_Shim_Views ( ).empty ());
+
+  ASSERT_TRUE (vdf.acquireFile ( ));
+  ASSERT_TRUE (vdf.acquireFile ( ));
+
+  // The file and its mapping
+  EXPECT_EQ (SKIF_Shim_OpenHandles ( ), handles + ((mode == LoadMode::Buffered) ? 0 : 2));
+
+  vdf.releaseFile ( );
+  EXPECT_EQ (SKIF_Shim_OpenHandles ( ), handles + ((mode == LoadMode::Buffered) ? 0 : 2));
+
+  vdf.releaseFile ( );
+  EXPECT_EQ (SKIF_Shim_OpenHandles ( ), handles);
+  EXPECT_TRUE (SKIF_Shim_Views ( ).empty ());
+}
+
+TEST_P (AppInfoReader, DoesNotReopenAChangedFile)
+{
+  auto [version, mode] = GetParam ();
+
+  appinfo_gen::config_s config;
+  config.version = version;
+  config.apps    = 100;
+
+  appinfo_gen::temp_file_s temp (config);
+  skValveDataFile          vdf  (temp.wpath, mode);
+
+  // Rewritten with the same contents, only the last write time differs
+  ASSERT_TRUE (appinfo_gen::write (config, temp.path));
+
+  struct timespec times [2] = { { 0, UTIME_OMIT }, { 1, 0 } };
+  ASSERT_EQ (utimensat (AT_FDCWD, temp.path.c_str (), times, 0), 0);
+
+  EXPECT_EQ (vdf.acquireFile ( ), mode == LoadMode::Buffered);
+
+  // A reader of the new file has no trouble with it, the old one keeps refusing
+  config.apps = 200;
+  ASSERT_TRUE (appinfo_gen::write (config, temp.path));
+
+  skValveDataFile refreshed (temp.wpath, mode);
+
+  EXPECT_EQ (refreshed.index.size (), config.apps);
+  EXPECT_TRUE (refreshed.acquireFile ( ));
+  refreshed.releaseFile ( );
+
+  EXPECT_EQ (vdf.acquireFile ( ), mode == LoadMode::Buffered);
+}
+
+INSTANTIATE_TEST_SUITE_P (Versions, AppInfoReader,
+  ::testing::Combine (::testing::Values (0x27u, 0x28u, 0x29u),
+                      ::testing::Values (LoadMode::Buffered, LoadMode::Mapped, LoadMode::Windowed)));
+
+class AppInfoParser : public ::testing::TestWithParam <uint32_t>
+{
+protected:
+  void SetUp (void) override
+  {
+    config.version = GetParam ();
+    config.apps    = 50;
+    config.blob    = 4096;
+
+    temp = std::make_unique <appinfo_gen::temp_file_s> (config);
+    vdf  = std::make_unique <skValveDataFile>          (temp->wpath, LoadMode::Buffered);
+  }
+
+  appinfo_gen::config_s                     config;
+  std::unique_ptr <appinfo_gen::temp_file_s> temp;
+  std::unique_ptr <skValveDataFile>          vdf;
+};
+
+TEST_P (AppInfoParser, FindsTheSectionsSKIFReads)
+{
+  section_s section;
+
+  auto apps = SKIF_Test_Apps (*vdf);
+
+  ASSERT_EQ (apps.size (), config.apps);
+
+  for (auto pApp : apps)
+  {
+    appinfo_s::section_desc_s desc { };
+    desc.blob = pApp->getRootSection (&desc.size);
+
+    section.parse (desc, *vdf);
+
+    EXPECT_FALSE (section.exception) << pApp->appid;
+    EXPECT_EQ    (SKIF_Test_CountRows (section, section_s::LaunchEntry,               section_s::_KeyId::executable), 1 + pApp->appid % 3);
+    EXPECT_EQ    (SKIF_Test_CountRows (section, section_s::Branch,                    section_s::_KeyId::buildid),    2u);
+    EXPECT_EQ    (SKIF_Test_CountRows (section, section_s::CommonLibraryCapsuleImage, section_s::_KeyId::english),    1u);
+    EXPECT_EQ    (SKIF_Test_CountRows (section, section_s::SaveFile,                  section_s::_KeyId::root),       1u);
+    EXPECT_EQ    (SKIF_Test_CountRows (section, section_s::RootOverride,              section_s::_KeyId::useinstead), 1u);
+  }
+}
+
+TEST_P (AppInfoParser, SelectiveParseOnlySkipsIgnoredSections)
+{
+  section_s selective, full;
+  full.selective = false;
+
+  for (auto pApp : SKIF_Test_Apps (*vdf))
+  {
+    appinfo_s::section_desc_s desc { };
+    desc.blob = pApp->getRootSection (&desc.size);
+
+    selective.parse (desc, *vdf);
+    full     .parse (desc, *vdf);
+
+    EXPECT_GT (selective.bytes_skipped, 0u);
+    EXPECT_EQ (full     .bytes_skipped, 0u);
+    EXPECT_LT (selective.tape.size (), full.tape.size ());
+
+    // Everything outside of the skipped subtrees ends up on both tapes, in the same order
+    size_t row = 0;
+
+    for (size_t full_row = 0; full_row < full.tape.size (); full_row++)
+    {
+      if (full.tape.path [full_row] == section_s::Ignored)
+        continue;
+
+      ASSERT_LT (row, selective.tape.size ());
+      EXPECT_EQ (selective.tape.value [row], full.tape.value [full_row]);
+      EXPECT_EQ (selective.tape.key   [row], full.tape.key   [full_row]);
+
+      row++;
+    }
+  }
+}
+
+TEST_P (AppInfoParser, TruncatedSectionsStayInBounds)
+{
+  section_s section;
+  section.selective = false;
+
+  auto pApp = SKIF_Test_Apps (*vdf).front ();
+
+  size_t size = 0;
+  auto   blob = static_cast <const uint8_t *> (pApp->getRootSection (&size));
+
+  for (size_t len = 0; len < size; len += 7)
+  {
+    // Exactly sized, so that reading past the end is caught by sanitizers
+    std::unique_ptr <uint8_t []> copy (new uint8_t [len]);
+    memcpy (copy.get (), blob, len);
+
+    appinfo_s::section_desc_s desc { copy.get (), len };
+
+    section.parse (desc, *vdf);
+
+    for (size_t row = 0; row < section.tape.size (); row++)
+    {
+      auto value = static_cast <const uint8_t *> (section.tape.value [row]);
+
+      ASSERT_GE (value, copy.get ());
+      ASSERT_LE (value, copy.get () + len);
+
+      if (section.tape.op [row] == section_s::String)
+        EXPECT_NE (memchr (value, '\0', copy.get () + len - value), nullptr);
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (Versions, AppInfoParser, ::testing::Values (0x27u, 0x28u, 0x29u));